@@ -0,0 +1,112 @@
+#include "block_cache.h"
+#include "jit.h"
+#include "ops.h"
+#include "scheduler.h"
+#include "state.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using std::cout;
+using std::dec;
+using std::free;
+using std::malloc;
+using std::max;
+using std::min;
+using std::size_t;
+using std::uint16_t;
+using std::uint32_t;
+using std::uint64_t;
+
+static uint64_t allocations = 0;
+
+void* operator new(size_t size)
+{
+    allocations++;
+    void* memory = malloc(size != 0 ? size : 1);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+const uint32_t FRAME_CYCLES = 114 * 154;
+const uint32_t WARMUP_FRAMES = 10;
+const uint32_t FRAMES = 600;
+
+/* Runs the CPU and the PPU and timer events like the main loop does, without
+ * a host, for frames of emulated time */
+static void run_frames(State& state, uint32_t (*run_cpu)(State&), uint32_t frames)
+{
+    uint64_t end = state.scheduler.now + static_cast<uint64_t>(frames) * FRAME_CYCLES;
+    while (state.scheduler.now < end && !state.stop_mode) {
+        if (state.interrupts.halted) {
+            state.scheduler.now = min(end, state.scheduler.next_deadline());
+        } else {
+            state.scheduler.now += run_cpu(state) / 4;
+        }
+        if (state.interrupts.pending != 0) {
+            uint16_t handler = state.interrupts.take(state.instructions_executed);
+            if (handler != 0) {
+                push_onto_stack(state, state.pc);
+                state.pc = handler;
+            }
+        }
+
+        Event event;
+        uint64_t when = 0;
+        while (state.scheduler.pop_due(event, when)) {
+            state.run_event(event, when);
+        }
+    }
+}
+
+/* Counts heap allocations per emulated frame for each CPU core, after a few
+ * frames of warm-up in which blocks get decoded and compiled */
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        cout << "Enter ROM filename as an argument.\n";
+        return 0;
+    }
+
+    struct Core {
+        const char* name;
+        uint32_t (*run_cpu)(State&);
+    };
+    const Core cores[] = {{"interpreter", execute_op}, {"block cache", execute_block_op}, {"jit", execute_jit_op}};
+    for (const Core& core : cores) {
+        State state;
+        if (!state.load_file_to_rom(argv[1])) {
+            cout << "Invalid ROM filename.\n";
+            return 0;
+        }
+        state.draw_lines = false;
+        state.write_memory(0xff40, 0x91);
+
+        run_frames(state, core.run_cpu, WARMUP_FRAMES);
+        uint64_t before = allocations;
+        uint64_t start = state.scheduler.now;
+        uint32_t instructions = state.instructions_executed;
+        run_frames(state, core.run_cpu, FRAMES);
+        /* STOP ends the run early */
+        double frames = max(1.0, static_cast<double>(state.scheduler.now - start) / FRAME_CYCLES);
+        cout << dec << core.name << ": " << (allocations - before) / frames << " allocations per frame over "
+             << frames << " frames, " << static_cast<uint64_t>((state.instructions_executed - instructions) / frames)
+             << " instructions per frame\n";
+    }
+}
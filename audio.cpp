@@ -1,4 +1,5 @@
 #include "audio.h"
+#include "snapshot.h"
 #include "state.h"
 
 #include <cstdint>
@@ -274,6 +275,64 @@ void AudioController::update_audio(State& state, uint32_t cycles)
     this->prev_nr52 = state.read_memory(0xff26);
 }
 
+void AudioController::save_state(SnapshotWriter& writer)
+{
+    SDL_LockAudioDevice(this->device);
+    writer.begin_chunk("APU ", 1);
+    writer.put(this->freq1);
+    writer.put(this->amp1);
+    writer.put(this->sweep_timer1);
+    writer.put(this->envelope_timer1);
+    writer.put(this->sound_timer1);
+    writer.put(this->duty_cycle1);
+    writer.put(this->sound_counter1);
+    writer.put(this->freq2);
+    writer.put(this->amp2);
+    writer.put(this->envelope_timer2);
+    writer.put(this->sound_timer2);
+    writer.put(this->duty_cycle2);
+    writer.put(this->sound_counter2);
+    writer.put(this->freq3);
+    writer.put(this->amp3);
+    writer.put(this->sound_timer3);
+    writer.put(this->wave_pattern);
+    writer.put(this->sound_counter3);
+    writer.put(this->freq4);
+    writer.put(this->amp4);
+    writer.put(this->envelope_timer4);
+    writer.put(this->sound_timer4);
+    writer.put(this->width_mode);
+    writer.put(this->shift_register);
+    writer.put(this->sound_counter4);
+    writer.put(this->prev_nr52);
+    writer.put(this->sound_enabled);
+    writer.end_chunk();
+    SDL_UnlockAudioDevice(this->device);
+}
+
+bool AudioController::load_state(SnapshotReader& reader)
+{
+    if (reader.open_chunk("APU ") != 1) {
+        return false;
+    }
+    /* The callback reads the channels while generating samples */
+    SDL_LockAudioDevice(this->device);
+    bool loaded = reader.get(this->freq1) && reader.get(this->amp1) && reader.get(this->sweep_timer1)
+                  && reader.get(this->envelope_timer1) && reader.get(this->sound_timer1)
+                  && reader.get(this->duty_cycle1) && reader.get(this->sound_counter1)
+                  && reader.get(this->freq2) && reader.get(this->amp2) && reader.get(this->envelope_timer2)
+                  && reader.get(this->sound_timer2) && reader.get(this->duty_cycle2)
+                  && reader.get(this->sound_counter2)
+                  && reader.get(this->freq3) && reader.get(this->amp3) && reader.get(this->sound_timer3)
+                  && reader.get(this->wave_pattern) && reader.get(this->sound_counter3)
+                  && reader.get(this->freq4) && reader.get(this->amp4) && reader.get(this->envelope_timer4)
+                  && reader.get(this->sound_timer4) && reader.get(this->width_mode)
+                  && reader.get(this->shift_register) && reader.get(this->sound_counter4)
+                  && reader.get(this->prev_nr52) && reader.get(this->sound_enabled);
+    SDL_UnlockAudioDevice(this->device);
+    return loaded;
+}
+
 double AudioController::create_rect_wave(uint32_t freq, uint32_t amp, float duty_cycle, double sound_counter, int16_t* buf, uint32_t len)
 {
     float wave_length = 1 / (float) freq;
@@ -6,6 +6,8 @@
 
 #include <SDL2/SDL.h>
 
+class SnapshotReader;
+class SnapshotWriter;
 
 class AudioController {
 friend void audio_callback(void* audio, std::uint8_t* stream, int _len);
@@ -13,6 +15,9 @@ public:
     AudioController();
     ~AudioController();
     void update_audio(State& state, std::uint32_t cycles);
+    /* The "APU " chunk of save states */
+    void save_state(SnapshotWriter& writer);
+    bool load_state(SnapshotReader& reader);
     double create_rect_wave(std::uint32_t freq, std::uint32_t amp, float duty_cycle,
 		          double sound_counter, std::int16_t* buf, std::uint32_t len);
     void repeat_wave_pattern(std::int16_t* buf, std::uint32_t len);
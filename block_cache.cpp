@@ -0,0 +1,148 @@
+#include "block_cache.h"
+#include "instruction.h"
+#include "mapper.h"
+#include "op_table.h"
+#include "ops.h"
+#include "state.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+using std::size_t;
+using std::uint8_t;
+using std::uint16_t;
+using std::uint32_t;
+
+bool address_cacheable(uint16_t addr)
+{
+    return addr <= 0x7fff || (addr >= 0xc000 && addr <= 0xdfff) || (addr >= 0xff80 && addr <= 0xfffe);
+}
+
+uint32_t code_bank(State& state, uint16_t addr)
+{
+    if (state.mapper != nullptr && addr <= 0x3fff) {
+        /* MBC1 can switch the bank at 0x0000 too */
+        return state.mapper->rom_bank_low;
+    } else if (state.mapper != nullptr && addr <= 0x7fff) {
+        return state.mapper->rom_bank_high;
+    } else if (state.cgb && addr >= 0xd000 && addr <= 0xdfff) {
+        return state.wram_bank;
+    }
+    return 0;
+}
+
+uint16_t code_region_end(uint16_t addr)
+{
+    if (addr <= 0x3fff) {
+        return 0x3fff;
+    } else if (addr <= 0x7fff) {
+        return 0x7fff;
+    } else if (addr <= 0xcfff) {
+        return 0xcfff;
+    } else if (addr <= 0xdfff) {
+        return 0xdfff;
+    } else {
+        return 0xfffe;
+    }
+}
+
+bool ends_block(const Instruction& instruction)
+{
+    return instruction.function == &JR || instruction.function == &JP
+        || instruction.function == &CALL || instruction.function == &RET
+        || instruction.function == &RETI || instruction.function == &RST
+        || instruction.function == &HALT || instruction.function == &STOP;
+}
+
+Block* BlockCache::find_block(State& state, uint16_t addr)
+{
+    if (!address_cacheable(addr)) {
+        return nullptr;
+    }
+
+    uint32_t key = code_bank(state, addr) << 16 | addr;
+    auto it = this->blocks.find(key);
+    if (it != this->blocks.end() && this->block_valid(state, it->second)) {
+        return &it->second;
+    }
+
+    Block& block = this->blocks[key];
+    this->compile_block(state, block, addr);
+    return block.ops.empty() ? nullptr : &block;
+}
+
+bool BlockCache::block_valid(State& state, const Block& block)
+{
+    if (block.ops.empty()) {
+        return false;
+    }
+
+    uint16_t addr = block.ops[0].addr;
+    if (block.bank != code_bank(state, addr)) {
+        return false;
+    }
+    if (addr >= 0xc000) {
+        return state.code_line_versions[block.first_line] == block.first_line_version
+            && state.code_line_versions[block.last_line] == block.last_line_version;
+    }
+    return true;
+}
+
+void BlockCache::compile_block(State& state, Block& block, uint16_t addr)
+{
+    uint16_t region_end = code_region_end(addr);
+    uint16_t pc = addr;
+
+    block.generation++;
+    block.bank = code_bank(state, addr);
+    block.ops.clear();
+    while (true) {
+        uint8_t op = state.read_memory(pc);
+        uint32_t bytes = (op == 0xcb) ? 2 : ops[op].bytes;
+        if (pc + bytes - 1 > region_end || pc + bytes - addr > MAX_BLOCK_BYTES) {
+            break;
+        }
+
+        CachedOp cached_op{pc, 0, {0, 0, 0}};
+        cached_op.opcode = fetch_op(state, pc, cached_op.op_code);
+        block.ops.push_back(cached_op);
+        pc += bytes;
+
+        if (ends_block(decode_instruction(cached_op.opcode))) {
+            break;
+        }
+    }
+
+    if (addr >= 0xc000 && !block.ops.empty()) {
+        /* Writes to these lines bump their version, which invalidates the block */
+        block.first_line = addr >> 6;
+        block.last_line = (pc - 1) >> 6;
+        block.first_line_version = state.code_line_versions[block.first_line];
+        block.last_line_version = state.code_line_versions[block.last_line];
+        state.code_lines[block.first_line] = 1;
+        state.code_lines[block.last_line] = 1;
+    }
+}
+
+uint32_t execute_block_op(State& state)
+{
+    if (state.block_cache == nullptr) {
+        state.block_cache = new BlockCache();
+    }
+    BlockCache& cache = *state.block_cache;
+
+    if (cache.current == nullptr || cache.position >= cache.current->ops.size()
+            || cache.current->ops[cache.position].addr != state.pc
+            || !cache.block_valid(state, *cache.current)) {
+        cache.current = cache.find_block(state, state.pc);
+        cache.position = 0;
+        if (cache.current == nullptr) {
+            return execute_op(state);
+        }
+    }
+
+    const CachedOp& cached_op = cache.current->ops[cache.position++];
+    return execute_decoded_op(state, cached_op.opcode, cached_op.op_code);
+}
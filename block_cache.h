@@ -0,0 +1,48 @@
+#pragma once
+
+#include "instruction.h"
+#include "state.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/* Blocks never span more than two of the 64-byte lines tracked in State::code_lines. */
+const std::uint32_t MAX_BLOCK_BYTES = 64;
+
+typedef struct CachedOp {
+    std::uint16_t addr;
+    std::uint16_t opcode;
+    OpCode op_code;
+} CachedOp;
+
+/* generation changes every time the block is decoded again. */
+typedef struct Block {
+    std::uint32_t generation;
+    std::uint32_t bank;
+    std::uint16_t first_line;
+    std::uint16_t last_line;
+    std::uint16_t first_line_version;
+    std::uint16_t last_line_version;
+    std::vector<CachedOp> ops;
+} Block;
+
+class BlockCache {
+public:
+    Block* find_block(State& state, std::uint16_t addr);
+    bool block_valid(State& state, const Block& block);
+
+    Block* current = nullptr;
+    std::size_t position = 0;
+private:
+    void compile_block(State& state, Block& block, std::uint16_t addr);
+
+    std::unordered_map<std::uint32_t, Block> blocks;
+};
+
+bool address_cacheable(std::uint16_t addr);
+std::uint32_t code_bank(State& state, std::uint16_t addr);
+std::uint16_t code_region_end(std::uint16_t addr);
+bool ends_block(const Instruction& instruction);
+std::uint32_t execute_block_op(State& state);
@@ -1,12 +1,12 @@
 #include "debug.h"
 #include "instruction.h"
+#include "ops.h"
 #include "state.h"
 
 #include <algorithm>
 #include <cstdint>
 #include <deque>
 #include <iostream>
-#include <vector>
 
 using std::cout;
 using std::deque;
@@ -14,7 +14,6 @@ using std::find;
 using std::hex;
 using std::uint8_t;
 using std::uint16_t;
-using std::vector;
  
 deque<uint16_t> recent_jumps;
 
@@ -31,23 +30,24 @@ void add_jump(std::uint16_t addr)
     }
 }
 
-void print_debug_info(State& state, Instruction& instruction, vector<uint8_t> op_code)
+void print_debug_info(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     cout << "Op code: ";
-    for (uint8_t b : op_code) {
-        cout << hex << (uint16_t) b << " ";
+    for (uint8_t i = 0; i < instruction.bytes; i++) {
+        cout << hex << (uint16_t) op_code[i] << " ";
     }
     cout << "Mnemonic: " << instruction.name;
-    if (instruction.operand_count >= 1) {cout << " " << instruction.operand1;}
-    if (instruction.operand_count >= 2) {cout << " " << instruction.operand2;}
+    if (instruction.operand_count >= 1) {cout << " " << instruction.operand1.name;}
+    if (instruction.operand_count >= 2) {cout << " " << instruction.operand2.name;}
     cout << "\n";
     cout << "PC: " << hex << state.pc << " SP: " << state.sp << "\n";
-    cout << "BC: " << hex << ((state.b << 8) | state.c) << " ";
-    cout << "DE: " << hex << ((state.d << 8) | state.e) << " ";
-    cout << "HL: " << hex << ((state.h << 8) | state.l) << "\n";
-    cout << "A: " << hex << (uint16_t) state.a << " ";
-    cout << "Flags: " << ((state.f & 0x80) != 0) << ((state.f & 0x40) != 0)
-	              << ((state.f & 0x20) != 0) << ((state.f & 0x10) != 0) <<  "\n";
+    cout << "BC: " << hex << state.read_pair(PAIR_BC) << " ";
+    cout << "DE: " << hex << state.read_pair(PAIR_DE) << " ";
+    cout << "HL: " << hex << state.read_pair(PAIR_HL) << "\n";
+    cout << "A: " << hex << (uint16_t) state.registers[REG_A] << " ";
+    uint8_t flags = read_flags(state);
+    cout << "Flags: " << ((flags & 0x80) != 0) << ((flags & 0x40) != 0)
+	              << ((flags & 0x20) != 0) << ((flags & 0x10) != 0) <<  "\n";
     cout << hex << "LCDC: " << (uint16_t) state.read_memory(0xff40) << " ";
     cout << hex << "STAT: " << (uint16_t) state.read_memory(0xff41) << " ";
     cout << hex << "LY: " << (uint16_t) state.read_memory(0xff44) << "\n\n";
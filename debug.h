@@ -5,10 +5,9 @@
 
 #include <cstdint>
 #include <deque>
-#include <vector>
 
 extern std::deque<std::uint16_t> recent_jumps;
 
 void add_jump(std::uint16_t addr);
 
-void print_debug_info(State& state, Instruction& instruction, std::vector<std::uint8_t> op_code);
+void print_debug_info(State& state, const Instruction& instruction, const OpCode& op_code);
@@ -85,9 +85,9 @@ void draw_line_background(State& state, SDL_Surface* display_surface)
 		    if (state.cgb && (attrs & 0x40)) {
 			tile_y_offset = 7 - tile_y_offset;
 		    }
-		    uint8_t* tile_data = ((attrs & 0x8) && state.cgb) ? state.tile_data2 : state.tile_data;
+		    const uint8_t* tile_row = state.tile_row((attrs & 0x8) && state.cgb, tiles[i] + tile_y_offset * 8);
 		    uint32_t color = 0;
-		    uint32_t shade = (tile_data[tiles[i] + tile_y_offset * 8 + tile_offset]);
+		    uint32_t shade = tile_row[tile_offset];
                     if (shade == 1) {
 		        shade = 2;
 		    } else if (shade == 2) {
@@ -157,7 +157,6 @@ void draw_line_window(State& state, SDL_Surface* display_surface)
 	            uint32_t tile_num = (display_row - window_y) / 8 * 32 + i;
                     uint8_t code_area = (lcdc & 0x40) >> 6;
 		    uint8_t attrs = state.read_vram_bank((code_area ? 0x1c00 : 0x1800) + tile_num);
-		    uint8_t* tile_data = ((attrs & 0x8) && state.cgb) ? state.tile_data2 : state.tile_data;
 		    uint32_t color = 0;
 		    uint8_t tile_offset = pixel;
 	            if (state.cgb && (attrs & 0x20)) {
@@ -167,7 +166,8 @@ void draw_line_window(State& state, SDL_Surface* display_surface)
 		    if (state.cgb && (attrs & 0x40)) {
 			tile_y_offset = 7 - tile_y_offset;
 		    }
-		    uint32_t shade = tile_data[tiles[i] + tile_y_offset * 8 + tile_offset];
+		    const uint8_t* tile_row = state.tile_row((attrs & 0x8) && state.cgb, tiles[i] + tile_y_offset * 8);
+		    uint32_t shade = tile_row[tile_offset];
                     if (shade == 1) {
 		        shade = 2;
 		    } else if (shade == 2) {
@@ -296,8 +296,8 @@ void draw_line_sprites(State& state, SDL_Surface* display_surface)
 	        }
 
 		uint32_t pixel_index = display_row * 160 + sprite_x + i;
-		uint8_t* tile_data = ((sprite_attrs & 0x8) && state.cgb) ? state.tile_data2 : state.tile_data;
-	        uint32_t shade = tile_data[tile_index + sprite_row * 8 + pixel];
+		const uint8_t* tile_row = state.tile_row((sprite_attrs & 0x8) && state.cgb, tile_index + sprite_row * 8);
+	        uint32_t shade = tile_row[pixel];
                 if (shade == 1) {
 		    shade = 2;
 		} else if (shade == 2) {
@@ -1,14 +1,24 @@
 #include "emulator.h"
 #include "audio.h"
+#include "block_cache.h"
 #include "display.h"
+#include "idle_loop.h"
+#include "input.h"
+#include "jit.h"
+#include "mapper.h"
 #include "ops.h"
+#include "rewind.h"
+#include "saver.h"
+#include "snapshot.h"
 #include "state.h"
 
 #include <algorithm>
 #include <cstdint>
 #include <cstddef>
 #include <experimental/filesystem>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -18,19 +28,65 @@
 
 using std::copy;
 using std::cout;
+using std::dec;
 using std::experimental::filesystem::create_directory;
 using std::error_code;
+using std::ifstream;
+using std::istreambuf_iterator;
 using std::experimental::filesystem::filesystem_error;
 using std::experimental::filesystem::is_regular_file;
+using std::max;
+using std::min;
+using std::move;
 using std::pair;
+using std::unique_ptr;
 using std::experimental::filesystem::path;
 using std::size_t;
 using std::string;
 using std::uint8_t;
+using std::uint16_t;
 using std::uint32_t;
+using std::uint64_t;
 using std::vector;
 
 bool quit = false;
+bool save_state_requested = false;
+bool load_state_requested = false;
+bool rewinding = false;
+
+/* Rewind keeps up to a minute of frames in at most 64 MiB */
+const size_t REWIND_FRAMES = 60 * 60;
+const size_t REWIND_BUDGET = 64 << 20;
+const uint32_t FRAME_CYCLES = 114 * 154;
+/* Host event periods in machine cycles at normal speed. Battery saves are
+ * written at most every 20 lines. */
+const uint32_t AUDIO_CYCLES = 100;
+const uint32_t SAVE_CYCLES = 114 * 20;
+/* While halted, audio is updated every 10 lines. That is still finer than
+ * its 1/128 s sweep steps. */
+const uint32_t HALT_AUDIO_CYCLES = 114 * 10;
+/* --headless runs a minute of emulated time as fast as it can */
+const uint64_t HEADLESS_CYCLES = 60 * 60 * FRAME_CYCLES;
+
+/* A rewind snapshot is a save state plus the finished frame to show */
+static vector<uint8_t> rewind_snapshot(State& state, SDL_Surface* display_buffer)
+{
+    SnapshotWriter writer;
+    state.save_state(writer);
+    writer.begin_chunk("LCD ", 1);
+    writer.put_bytes(display_buffer->pixels, display_buffer->pitch * display_buffer->h);
+    writer.end_chunk();
+    return move(writer.data);
+}
+
+static bool load_rewind_snapshot(State& state, SDL_Surface* display_buffer, const vector<uint8_t>& data)
+{
+    SnapshotReader reader(data.data(), data.size());
+    if (!state.load_state(reader) || reader.open_chunk("LCD ") != 1) {
+        return false;
+    }
+    return reader.get_bytes(display_buffer->pixels, display_buffer->pitch * display_buffer->h);
+}
 
 int main(int argc, char* argv[])
 {
@@ -39,19 +95,55 @@ int main(int argc, char* argv[])
 	return 0;
     }
 
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) != 0) {
+    uint32_t (*run_cpu)(State&) = execute_op;
+    bool mmap_save = false;
+    bool headless = false;
+    bool idle_skip = true;
+    unique_ptr<RewindBuffer> rewind;
+    Joypad joypad;
+    InputScript input_script;
+    bool scripted = false;
+    for (int i = 2; i < argc; i++) {
+        if (string(argv[i]) == "--block-cache") {
+	    run_cpu = execute_block_op;
+	} else if (string(argv[i]) == "--jit") {
+	    run_cpu = execute_jit_op;
+	} else if (string(argv[i]) == "--jit-diff") {
+	    run_cpu = execute_jit_diff_op;
+	} else if (string(argv[i]) == "--mmap-save") {
+	    mmap_save = true;
+	} else if (string(argv[i]) == "--rewind") {
+	    rewind.reset(new RewindBuffer(REWIND_BUDGET, REWIND_FRAMES));
+	} else if (string(argv[i]) == "--headless") {
+	    headless = true;
+	} else if (string(argv[i]) == "--no-idle-skip") {
+	    idle_skip = false;
+	} else if (string(argv[i]) == "--input" && i + 1 < argc) {
+	    if (!input_script.load(argv[++i])) {
+	        return 0;
+	    }
+	    scripted = true;
+	}
+    }
+
+    if (SDL_Init(headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO | SDL_INIT_EVENTS) != 0) {
 	cout << "SDL2 failed to initialize: " << SDL_GetError() << "\n";
 	return 0;
     }
 
-    SDL_Window* window = SDL_CreateWindow("GameBoy Emulator",
-		                          SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
-					  SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
-    if (!window) {
-	cout << "Failed to create window: " << SDL_GetError() << "\n";
-	return 0;
+    /* Headless runs only draw into the buffer */
+    SDL_Window* window = nullptr;
+    SDL_Surface* display_surface = nullptr;
+    if (!headless) {
+        window = SDL_CreateWindow("GameBoy Emulator",
+		                  SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+				  SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+	if (!window) {
+	    cout << "Failed to create window: " << SDL_GetError() << "\n";
+	    return 0;
+	}
+	display_surface = SDL_GetWindowSurface(window);
     }
-    SDL_Surface* display_surface = SDL_GetWindowSurface(window);
     SDL_Surface* display_buffer = SDL_CreateRGBSurface(0, 160, 144, 32, 0, 0, 0, 0);
 
     State state;
@@ -59,22 +151,33 @@ int main(int argc, char* argv[])
         cout << "Invalid ROM filename.\n";
 	return 0;
     }
+    /* Without a window or rewind history, nothing would show the lines */
+    state.draw_lines = window != nullptr || rewind != nullptr;
 
     string save_file_name = argv[1];
     save_file_name = "saves/" + path(save_file_name).stem().string() + ".sav";
 
     try {
         create_directory("saves");
-	if (is_regular_file(save_file_name)) {
+	if (mmap_save && !state.map_save_file(save_file_name)) {
+	    cout << "[WARNING]: Could not map the save file, saving copies instead.\n";
+	    mmap_save = false;
+	}
+	if (!mmap_save && is_regular_file(save_file_name)) {
 	    state.load_file_to_memory(save_file_name, "ram");
 	}
     } catch (const filesystem_error& e) {
         cout << e.what();
 	return 0;
     }
+    BatterySaver saver(save_file_name);
+    string state_file_name = "saves/" + path(argv[1]).stem().string() + ".state";
+    BatterySaver state_saver(state_file_name);
 
-    state.a = 0x11; state.f = 0xb0; state.b = 0x00; state.c = 0x13;
-    state.d = 0x00; state.e = 0xd8; state.h = 0x01; state.l = 0x4d;
+    state.write_pair(PAIR_AF, 0x11b0);
+    state.write_pair(PAIR_BC, 0x0013);
+    state.write_pair(PAIR_DE, 0x00d8);
+    state.write_pair(PAIR_HL, 0x014d);
 
     vector<pair<uint16_t, uint8_t>> memory_values = {
         {0xff00, 0xff}, {0xff05, 0x00}, {0xff06, 0x00}, {0xff07, 0x00},
@@ -86,215 +189,240 @@ int main(int argc, char* argv[])
         state.write_memory(value.first, value.second);
     }
 
-    uint32_t last_time_ms = SDL_GetTicks();
+    uint32_t start_time_ms = SDL_GetTicks();
+    uint32_t last_time_ms = start_time_ms;
     uint32_t current_time_ms = last_time_ms;
     uint32_t cycles_to_catch_up = 0;
-    uint8_t draw_line_counter = 0;
-    uint16_t timer_counter = 0;
-    uint16_t divider_counter = 0;
-    uint16_t event_counter = 0;
-    uint16_t audio_counter = 0;
-    uint16_t save_counter = 0;
+    bool save_synced = false;
+    uint64_t audio_time = state.scheduler.now;
+    uint64_t frames = 0;
+    uint64_t emulated_cycles = 0;
+    uint64_t halted_cycles = 0;
+    IdleLoopDetector idle_loops;
+    state.scheduler.schedule(Event::AUDIO_UPDATE, state.scheduler.now + AUDIO_CYCLES);
+    state.scheduler.schedule(Event::BATTERY_SAVE, state.scheduler.now + SAVE_CYCLES);
     while (!quit) {
 	current_time_ms = SDL_GetTicks();
 	cycles_to_catch_up += (current_time_ms - last_time_ms) * 1048;
 	last_time_ms = current_time_ms;
-	if (cycles_to_catch_up > 20000) {
+	if (cycles_to_catch_up > 20000 || headless) {
 	    cycles_to_catch_up = 20000;
 	}
-	handle_events(state);
-	if ((state.read_memory(0xff00) & 0xf) != 0xf || state.read_memory(0xff0f) & 0x10) {state.stop_mode = false;}
-
-	while (!quit && cycles_to_catch_up > 20 && !state.stop_mode) {
-            uint8_t cycles_executed = 1;
-            if (!state.halt_mode) {
- 	        cycles_executed = execute_op(state) / 4;
+	/* Nothing can end a STOP without input */
+	if (headless && (emulated_cycles >= HEADLESS_CYCLES || state.stop_mode)) {
+	    break;
+	}
+	/* Input is latched between time slices, so the CPU loop never asks SDL */
+	handle_events(joypad);
+	state.set_buttons(joypad.buttons());
+	if (save_state_requested) {
+	    SnapshotWriter writer;
+	    state.save_state(writer);
+	    audio_controller.save_state(writer);
+	    state_saver.save(move(writer.data));
+	    save_state_requested = false;
+	}
+	if (load_state_requested) {
+	    ifstream state_file(state_file_name, ifstream::binary);
+	    vector<uint8_t> data((istreambuf_iterator<char>(state_file)), istreambuf_iterator<char>());
+	    SnapshotReader reader(data.data(), data.size());
+	    if (!state.load_state(reader) || !audio_controller.load_state(reader)) {
+	        cout << "[WARNING]: Could not load save state " << state_file_name << ".\n";
 	    }
-
-	    uint8_t speed = state.double_speed ? 2 : 1;
- 	    cycles_to_catch_up -= cycles_executed * speed;
-	    draw_line_counter += cycles_executed;
-	    timer_counter += cycles_executed * speed;
-	    divider_counter += cycles_executed * speed;
-	    event_counter += cycles_executed;
-	    audio_counter += cycles_executed;
- 	    if (cycles_to_catch_up < 20) {break;}
-
-	    if (event_counter >= 100) {
-	        handle_events(state);
-		event_counter -= 100;
+	    load_state_requested = false;
+	}
+	/* Step back one frame per frame of real time while rewinding */
+	if (rewind != nullptr && rewinding) {
+	    vector<uint8_t> snapshot;
+	    if (cycles_to_catch_up >= FRAME_CYCLES && rewind->pop(snapshot)
+	        && load_rewind_snapshot(state, display_buffer, snapshot)) {
+	        cycles_to_catch_up -= FRAME_CYCLES;
+		SDL_BlitScaled(display_buffer, 0, display_surface, 0);
+	        SDL_UpdateWindowSurface(window);
 	    }
-
-	    uint8_t speed_reg = state.read_memory(0xff4d);
-	    state.write_memory(0xff4d, speed_reg | (state.double_speed ? 0x80 : 0x0));
-
-	    if (state.read_memory(0xff44) >= 144) {
-		state.write_memory(0xff41, (state.read_memory(0xff41) & ~0x2) | 0x1);
-	    } else if (draw_line_counter >= 63) {
-		state.write_memory(0xff41, state.read_memory(0xff41) & ~0x3);
-            } else if (draw_line_counter >= 20) {
-		state.write_memory(0xff41, state.read_memory(0xff41) | 0x3);
-            } else {
-		state.write_memory(0xff41, (state.read_memory(0xff41) & ~0x1) | 0x2);
+	    cycles_to_catch_up = min<uint32_t>(cycles_to_catch_up, FRAME_CYCLES);
+	    continue;
+	}
+	if ((state.read_memory(0xff00) & 0xf) != 0xf || state.interrupts.read_if() & 0x10) {state.stop_mode = false;}
+	if (mmap_save && state.stop_mode && !save_synced) {
+	    state.mapper->sync_save_file(true);
+	}
+	save_synced = state.stop_mode;
+
+	/* Run the CPU up to the next deadline, then the events that are due. A
+	 * speed switch ends the slice, since run_until counts at the old speed. */
+	uint8_t speed = state.double_speed ? 2 : 1;
+	uint64_t run_until = state.scheduler.now + cycles_to_catch_up * speed;
+	while (!quit && !state.stop_mode && state.scheduler.now < run_until && state.double_speed == (speed == 2)) {
+	    uint64_t deadline = min(run_until, state.scheduler.next_deadline());
+	    if (state.interrupts.halted) {
+	        /* Only an event can end HALT */
+		halted_cycles += max(state.scheduler.now, deadline) - state.scheduler.now;
+	        state.scheduler.now = max(state.scheduler.now, deadline);
 	    }
-
-	    if (draw_line_counter >= 114) {
-	        save_counter++;
-                if (state.save_pending && save_counter >= 20) {
-		    save_counter = 0;
-		    state.dump_memory_to_file(save_file_name, "ram");
-		    state.save_pending = false;
-		}
-
-		if (state.read_memory(0xff44) <= 143 && !(state.read_memory(0xff55) & 0x80)) {
-		    state.run_hdma();
+	    while (!state.interrupts.halted && state.scheduler.now < deadline && state.double_speed == (speed == 2)) {
+	        uint16_t pc = state.pc;
+	        state.scheduler.now += run_cpu(state) / 4;
+		handle_interrupts(state);
+		/* A write to the timer or LCD registers can bring an event forward */
+		deadline = min(run_until, state.scheduler.next_deadline());
+		/* A short branch back may close a busy-wait loop */
+		if (idle_skip && static_cast<uint16_t>(pc - state.pc) < MAX_IDLE_LOOP_BYTES) {
+		    state.scheduler.now += idle_loops.check(state, pc, deadline);
 		}
-
-	        uint8_t lcdc = state.read_memory(0xff40);
-	        if ((lcdc & 0x80) == 0x80) {
-                    if (state.read_memory(0xff44) == 0) {
-	                state.update_tile_data();
-	            }
- 
-		    draw_display_line(state, display_buffer);
-                    state.write_memory(0xff44, (state.read_memory(0xff44) + 1) % 154);
-		    draw_line_counter -= 114;
-		    uint8_t ly = state.read_memory(0xff44);
-
-		    uint8_t lcd_stat = state.read_memory(0xff41);
-		    bool lyc = ly == state.read_memory(0xff45);
-                    if ((lcd_stat & 0x8) || (lcd_stat & 0x20) || ((lcd_stat & 0x40) && lyc)) {
-			state.write_memory(0xff0f, state.read_memory(0xff0f) | 0x2);
-			if (state.read_memory(0xffff) & 0x2) {
-			    state.halt_mode = false;
-			}
-		    }
-		    if (lyc) {
-		        state.write_memory(0xff41, lcd_stat | 0x4);
-		    } else {
-		        state.write_memory(0xff41, lcd_stat & ~0x4);
+	    }
+	    /* Events and the host can change what a watched loop reads */
+	    idle_loops.reset();
+
+	    Event event;
+	    uint64_t when = 0;
+	    uint64_t elapsed = 0;
+	    while (state.scheduler.pop_due(event, when)) {
+	        switch (event) {
+		case Event::LCD_HBLANK:
+		    if (state.draw_lines) {
+		        draw_display_line(state, display_buffer);
 		    }
-
-		    if (ly == 144) {
-			state.write_memory(0xff0f, state.read_memory(0xff0f) | 0x1);
-			if (lcd_stat & 0x10) {
-			    state.write_memory(0xff0f, state.read_memory(0xff0f) | 0x2);
+		    state.run_event(event, when);
+		    break;
+		case Event::LINE_END:
+		    state.run_event(event, when);
+		    if (state.read_memory(0xff44) == 144) {
+			frames++;
+			if (scripted) {
+			    input_script.play(frames, joypad);
+			    state.set_buttons(joypad.buttons());
+			}
+			if (mmap_save) {
+			    state.mapper->sync_save_file(false);
+			}
+			if (window != nullptr) {
+			    SDL_BlitScaled(display_buffer, 0, display_surface, 0);
+	                    SDL_UpdateWindowSurface(window);
 			}
-			if ((state.read_memory(0xffff) & 0x1)
-				|| ((state.read_memory(0xffff) & 0x2) && (lcd_stat & 0x10))) {
-			    state.halt_mode = false;
+			if (rewind != nullptr) {
+			    rewind->push(rewind_snapshot(state, display_buffer));
 			}
-			SDL_BlitScaled(display_buffer, 0, display_surface, 0);
-	                SDL_UpdateWindowSurface(window);
 		    }
-                } else {
-                    state.write_memory(0xff44, 0);
+		    break;
+		case Event::AUDIO_UPDATE:
+		    /* Loading a state can move the clock back */
+		    elapsed = when > audio_time ? min<uint64_t>(when - audio_time, HALT_AUDIO_CYCLES * speed) : 0;
+		    audio_controller.update_audio(state, elapsed / speed);
+		    audio_time = when;
+		    state.scheduler.schedule(event, when + (state.interrupts.halted ? HALT_AUDIO_CYCLES : AUDIO_CYCLES) * speed);
+		    break;
+		case Event::BATTERY_SAVE:
+		    if (!mmap_save && state.save_pending) {
+		        saver.save(state.mapper->save_data());
+			state.save_pending = false;
+		    }
+		    state.scheduler.schedule(event, when + SAVE_CYCLES * speed);
+		    break;
+		default:
+		    state.run_event(event, when);
+		    break;
 		}
 	    }
-
-            if (divider_counter >= 256) {
-                divider_counter -= 256;
-		state.write_memory(0xff04, state.read_memory(0xff04) + 1);
+	    handle_interrupts(state);
+	    if (!state.interrupts.halted) {
+	        /* Catch up soon on audio batched while halted */
+		uint64_t audio_deadline = state.scheduler.now + AUDIO_CYCLES * speed;
+		if (state.scheduler.deadline(Event::AUDIO_UPDATE) > audio_deadline) {
+		    state.scheduler.schedule(Event::AUDIO_UPDATE, audio_deadline);
+		}
 	    }
+	}
+	uint32_t cycles_left = state.scheduler.now < run_until ? (run_until - state.scheduler.now) / speed : 0;
+	emulated_cycles += cycles_to_catch_up - cycles_left;
+	cycles_to_catch_up = cycles_left;
 
-            uint8_t timer_control = state.read_memory(0xff07);
-	    uint16_t cycles = 0;
-	    if ((timer_control & 0x3) == 0) {cycles = 1024;}
-	    if ((timer_control & 0x3) == 1) {cycles = 16;}
-	    if ((timer_control & 0x3) == 2) {cycles = 64;}
-	    if ((timer_control & 0x3) == 3) {cycles = 256;}
+	/* Give the rest of the millisecond back to the host instead of spinning */
+	if (!headless && SDL_GetTicks() == current_time_ms) {
+	    SDL_Delay(1);
+	}
+    }
 
-	    if (timer_control & 0x4 && timer_counter >= cycles) {
-		uint8_t timer = state.read_memory(0xff05);
-                timer_counter -= cycles;
-		timer++;
-		if (timer == 0) {
-                    timer = state.read_memory(0xff06);
-		    state.write_memory(0xff0f, state.read_memory(0xff0f) | 0x4);
-		    if (state.read_memory(0xffff) & 0x4) {
-			state.halt_mode = false;
-	            }
-		}
-		state.write_memory(0xff05, timer);
-	    }
+    if (!mmap_save && state.save_pending) {
+        saver.save(state.mapper->save_data());
+    }
 
-	    uint8_t p1 = state.read_memory(0xff00);
-	    if ((p1 & 0x30) == 0x20) {
-                const uint8_t* keyboard = SDL_GetKeyboardState(0);
-                uint8_t down = keyboard[SDL_SCANCODE_DOWN];
-                uint8_t up = keyboard[SDL_SCANCODE_UP];
-                uint8_t left = keyboard[SDL_SCANCODE_LEFT];
-                uint8_t right = keyboard[SDL_SCANCODE_RIGHT];
-		state.write_memory(0xff00, (p1 & 0xf0) | (~((down << 3) | (up << 2) | (left << 1) | right) & 0x0f));
-	    } else if ((p1 & 0x30) == 0x10) {
-                const uint8_t* keyboard = SDL_GetKeyboardState(0);
-                uint8_t start = keyboard[SDL_SCANCODE_Z];
-                uint8_t select = keyboard[SDL_SCANCODE_X];
-                uint8_t b = keyboard[SDL_SCANCODE_S];
-                uint8_t a = keyboard[SDL_SCANCODE_A];
-		state.write_memory(0xff00, (p1 & 0xf0) | (~((start << 3) | (select << 2) | (b << 1) | a) & 0x0f));
-	    } else {
-		state.write_memory(0xff00, 0x3f);
-	    }
+    if (headless) {
+        uint32_t elapsed_ms = SDL_GetTicks() - start_time_ms;
+	cout << dec << "Ran " << frames << " frames in " << elapsed_ms << " ms, "
+	     << halted_cycles * 100 / max<uint64_t>(state.scheduler.now, 1) << "% of cycles halted.\n";
+    }
 
-	    if (audio_counter >= 100) {
-                audio_counter -= 100;
-		audio_controller.update_audio(state, 100);
-	    }
+    if (idle_skip && (headless || idle_loops.skips != 0)) {
+        idle_loops.report(cout, state.scheduler.now);
+    }
 
-	    handle_interrupts(state);
-        }
-	if (state.cgb && state.stop_mode && state.read_memory(0xff4d) & 1) {
-	    state.double_speed = !state.double_speed;
-	    state.write_memory(0xff4d, state.double_speed ? 0x80 : 0x0);
-	}
+    if (rewind != nullptr && rewind->frames() != 0) {
+        size_t frames = rewind->frames();
+        size_t bytes = rewind->bytes_used();
+	cout << "Rewind history: " << frames / 60.0 << " s in " << bytes / 1024 << " KiB, "
+	     << bytes * 60 / frames / 1024 << " KiB per second.\n";
     }
 
     SDL_DestroyWindow(window);
     SDL_Quit();
 }
 
-void handle_events(State& state)
+/* Keyboard keys of the joypad buttons, in State::set_buttons() bit order */
+static const SDL_Scancode BUTTON_KEYS[8] = {
+    SDL_SCANCODE_RIGHT, SDL_SCANCODE_LEFT, SDL_SCANCODE_UP, SDL_SCANCODE_DOWN,
+    SDL_SCANCODE_A, SDL_SCANCODE_S, SDL_SCANCODE_X, SDL_SCANCODE_Z
+};
+
+void handle_events(Joypad& joypad)
 {
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
         if (e.type == SDL_QUIT) {
 	    quit = true;
-	} else if (e.type == SDL_KEYDOWN) {
-            switch (e.key.keysym.sym) {
-                case SDLK_DOWN:
-                case SDLK_UP:
-                case SDLK_LEFT:
-                case SDLK_RIGHT:
-                case SDLK_z:
-                case SDLK_x:
-                case SDLK_a:
-                case SDLK_b:
-		    state.write_memory(0xff0f, state.read_memory(0xff0f) | 0x10);
-		    if (state.read_memory(0xffff) & 0x10) {
-		        state.halt_mode = false;
-		    }
-                    break;
+	    continue;
+	} else if (e.type != SDL_KEYDOWN && e.type != SDL_KEYUP) {
+	    continue;
+	}
+
+	for (uint8_t button = 0; button < 8; button++) {
+	    if (e.key.keysym.scancode == BUTTON_KEYS[button]) {
+	        if (e.type == SDL_KEYDOWN) {
+		    joypad.press(static_cast<Button>(button));
+		} else {
+		    joypad.release(static_cast<Button>(button));
+		}
+	    }
+	}
+	if (e.type == SDL_KEYUP) {
+	    if (e.key.keysym.sym == SDLK_BACKSPACE) {
+	        rewinding = false;
 	    }
+	    continue;
+	}
+        switch (e.key.keysym.sym) {
+            case SDLK_F5:
+                save_state_requested = true;
+                break;
+            case SDLK_F8:
+                load_state_requested = true;
+                break;
+            case SDLK_BACKSPACE:
+                rewinding = true;
+                break;
 	}
     }
 }
 
 void handle_interrupts(State& state)
 {
-    uint8_t IF = state.read_memory(0xff0f);
-    if (!state.interrupts_enabled || (IF & 0x1f) == 0) {
+    /* Nothing is both requested and enabled between almost all instructions */
+    if (state.interrupts.pending == 0) {
         return;
     }
-    uint8_t IE = state.read_memory(0xffff);
-    for (uint8_t b = 0; b < 5; b++) {
-	if (IF & (1 << b) && IE & (1 << b)) {
-            state.write_memory(0xff0f, IF & ~(1 << b));
-	    state.interrupts_enabled = false;
-	    state.halt_mode = false;
-	    push_onto_stack(state, state.pc);
-	    state.pc = 0x40 + 0x8 * b;
-	    break;
-	}
+    uint16_t handler = state.interrupts.take(state.instructions_executed);
+    if (handler != 0) {
+        push_onto_stack(state, state.pc);
+        state.pc = handler;
     }
 }
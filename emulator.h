@@ -1,14 +1,22 @@
 #pragma once
 
+#include "input.h"
 #include "state.h"
 
+#include <cstdint>
 #include <string>
 
 extern bool quit;
+/* Set by F5 and F8, handled between frames */
+extern bool save_state_requested;
+extern bool load_state_requested;
+/* Held down with backspace */
+extern bool rewinding;
 
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 576;
 
 int main(int argc, char* argv[]);
-void handle_events(State& state);
+/* Handles window events and presses or releases the buttons of joypad keys */
+void handle_events(Joypad& joypad);
 void handle_interrupts(State& state);
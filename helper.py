@@ -16,32 +16,80 @@ ops['unprefixed']['0xf4'] = ops['unprefixed']['0x0']
 ops['unprefixed']['0xfc'] = ops['unprefixed']['0x0']
 ops['unprefixed']['0xfd'] = ops['unprefixed']['0x0']
 
+# Mnemonics that share a handler with another instruction
+handlers = {'SCF': 'NOP', 'LDH': 'LD', 'PREFIX': 'NOP'}
+
+registers = {'B': 'REG_B', 'C': 'REG_C', 'D': 'REG_D', 'E': 'REG_E',
+             'H': 'REG_H', 'L': 'REG_L', 'A': 'REG_A'}
+register_pairs = {'BC': 'PAIR_BC', 'DE': 'PAIR_DE', 'HL': 'PAIR_HL', 'AF': 'PAIR_AF'}
+conditions = {'NZ': 'COND_NZ', 'Z': 'COND_Z', 'NC': 'COND_NC', 'C': 'COND_C'}
+conditional_ops = ['JR', 'JP', 'CALL', 'RET']
+operand_kinds = {'SP': 'SP', 'd8': 'D8', 'd16': 'D16', 'a16': 'A16', 'r8': 'R8',
+                 'SP+r8': 'SP_R8', '(HL+)': 'MEM_HL_INC', '(HL-)': 'MEM_HL_DEC',
+                 '(a8)': 'MEM_A8', '(a16)': 'MEM_A16', '(C)': 'MEM_C'}
+
+def decode_operand(op, operand):
+    name = op.get(operand, 'NONE')
+    kind, value = 'NONE', '0'
+    if operand == 'operand1' and op['mnemonic'] in conditional_ops and name in conditions:
+        kind, value = 'CONDITION', conditions[name]
+    elif name in registers:
+        kind, value = 'REGISTER', registers[name]
+    elif name in register_pairs:
+        kind, value = 'REGISTER_PAIR', register_pairs[name]
+    elif name[1:-1] in register_pairs:
+        kind, value = 'MEM_REGISTER_PAIR', register_pairs[name[1:-1]]
+    elif name in operand_kinds:
+        kind = operand_kinds[name]
+    elif name.endswith('H'):
+        kind, value = 'LITERAL', hex(int(name[:-1], base=16))
+    elif name.isdigit():
+        kind, value = 'LITERAL', hex(int(name))
+    elif name == 'CB':
+        kind, value = 'LITERAL', '0xcb'
+    return '{{OperandKind::{}, {}, "{}"}}'.format(kind, value, name)
+
+def flag_mask(flags, effect):
+    flag_dict = {'1' : 'SET',
+                 '0' : 'CLEAR',
+                 '-' : 'IGNORE'}
+    bits = [name for name, flag in zip(['FLAG_Z', 'FLAG_N', 'FLAG_H', 'FLAG_C'], flags)
+            if flag_dict.get(flag, 'APPLY') == effect]
+    return ' | '.join(bits) if bits else '0'
+
 def write_ops(f, op_dict):
-    format_str = '{{{}, {}, {}, {}, {}, {}, {}, {}}},\n'
+    format_str = '{{{}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}}},\n'
     for opcode, op in sorted(op_dict.items(), key=lambda i: int(i[0], base=16)):
         name = '"' + op['mnemonic'] + '"'
+        function = '&' + handlers.get(op['mnemonic'], op['mnemonic'])
         op_bytes = op['bytes']
         operand_count = op['operand_count']
-        operand1 = '"' + op.get('operand1', 'NONE') + '"'
-        operand2 = '"' + op.get('operand2', 'NONE') + '"'
+        operand1 = decode_operand(op, 'operand1')
+        operand2 = decode_operand(op, 'operand2')
         cycles = op['cycles'][0]
         branch_cycles = op['cycles'][1] if len(op['cycles']) >= 2 else 0
-        flag_dict = {'1' : 'FlagEffect::SET',
-                     '0' : 'FlagEffect::CLEAR',
-                     '-' : 'FlagEffect::IGNORE'}
-        flags = [flag_dict.get(flag, 'FlagEffect::APPLY') for flag in op['flags_ZHNC']]
-        flags = '{{{}}}'.format(', '.join(flags))
+        flags = op['flags_ZHNC']
+        flags_apply = flag_mask(flags, 'APPLY')
+        flags_set = flag_mask(flags, 'SET')
+        flags_clear = flag_mask(flags, 'CLEAR')
         f.write(format_str.format(
-            name, op_bytes, operand_count, operand1, operand2, cycles,
-            branch_cycles, flags))
+            name, function, op_bytes, operand_count, operand1, operand2, cycles,
+            branch_cycles, flags_apply, flags_set, flags_clear))
 
 
-with open('op_table.cpp', 'w') as f:
-    f.write('#include "op_table.h"\n')
-    f.write('#include "instruction.h"\n\n')
-    f.write('#include <vector>\n\n')
-    f.write('std::vector<Instruction> ops = {\n')
+with open('op_table.h', 'w') as f:
+    f.write('#pragma once\n\n')
+    f.write('#include "instruction.h"\n')
+    f.write('#include "ops.h"\n\n')
+    f.write('#include <array>\n')
+    f.write('#include <cstdint>\n\n')
+    f.write('inline constexpr std::array<Instruction, 256> ops = {{\n')
     write_ops(f, ops['unprefixed'])
-    f.write('};\nstd::vector<Instruction> ops_cb = {\n')
+    f.write('}};\ninline constexpr std::array<Instruction, 256> ops_cb = {{\n')
     write_ops(f, ops['cbprefixed'])
-    f.write('};\n')
+    f.write('}};\n\n')
+    f.write('/* Opcodes 0x100-0x1ff are the CB-prefixed instructions. */\n')
+    f.write('constexpr const Instruction& decode_instruction(std::uint16_t opcode)\n')
+    f.write('{\n')
+    f.write('    return opcode >= 0x100 ? ops_cb[opcode & 0xff] : ops[opcode];\n')
+    f.write('}\n')
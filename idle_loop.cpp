@@ -0,0 +1,211 @@
+#include "idle_loop.h"
+#include "block_cache.h"
+#include "instruction.h"
+#include "op_table.h"
+#include "ops.h"
+#include "state.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ios>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+using std::dec;
+using std::hex;
+using std::memcmp;
+using std::memcpy;
+using std::min;
+using std::ostream;
+using std::int8_t;
+using std::uint8_t;
+using std::uint16_t;
+using std::uint32_t;
+using std::uint64_t;
+
+static bool reads_memory(const Operand& operand)
+{
+    return operand.kind == OperandKind::MEM_REGISTER_PAIR || operand.kind == OperandKind::MEM_A8
+           || operand.kind == OperandKind::MEM_A16 || operand.kind == OperandKind::MEM_C;
+}
+
+/* Whether an instruction of a loop body leaves memory, the stack and the
+ * interrupt state alone. Register and flag changes are caught by comparing
+ * the CPU state between iterations. */
+static bool only_reads(const Instruction& instruction)
+{
+    OpFunction function = instruction.function;
+    if (function == &PUSH || function == &POP || function == &CALL || function == &RET
+        || function == &RETI || function == &RST || function == &EI || function == &DI
+        || function == &HALT || function == &STOP) {
+        return false;
+    }
+
+    for (const Operand& operand : {instruction.operand1, instruction.operand2}) {
+        if (operand.kind == OperandKind::MEM_HL_INC || operand.kind == OperandKind::MEM_HL_DEC) {
+	    return false;
+	}
+    }
+    if (!reads_memory(instruction.operand1) && !reads_memory(instruction.operand2)) {
+        return true;
+    }
+
+    /* Memory operands are only accepted where they are known sources: the
+     * ALU ops and BIT read them, LD reads its second operand. Everything
+     * else with one, like INC, the rotates, SET and RES, writes it back. */
+    if (function == &ADD || function == &ADC || function == &SUB || function == &SBC
+        || function == &AND || function == &OR || function == &XOR || function == &CP || function == &BIT) {
+        return true;
+    }
+    return function == &LD && !reads_memory(instruction.operand1);
+}
+
+static uint16_t read_address(const State& state, const IdleLoopRead& read)
+{
+    if (read.kind == OperandKind::MEM_REGISTER_PAIR) {
+        return (state.registers[2 * read.value] << 8) | state.registers[2 * read.value + 1];
+    } else if (read.kind == OperandKind::MEM_C) {
+        return 0xff00 + state.registers[REG_C];
+    }
+    return read.addr;
+}
+
+uint64_t IdleLoopDetector::check(State& state, uint16_t branch_pc, uint64_t deadline)
+{
+    uint64_t now = state.scheduler.now;
+    /* Pending flags match when the same operation on the same operands is
+     * pending. F is compared either way, since it still holds the carry and
+     * half carry that ADC, SBC and DAA read while flags are pending. */
+    bool same_flags = state.flags_pending == this->flags_pending
+                      && (!state.flags_pending || (state.pending_flags_opcode == this->pending_flags_opcode
+                                                   && state.pending_flags_operands == this->pending_flags_operands));
+    bool repeated = this->watching && state.pc == this->head && state.sp == this->sp && same_flags
+                    && state.interrupts.enabled == this->interrupts_enabled
+                    && memcmp(state.registers, this->registers, sizeof(this->registers)) == 0;
+    if (!repeated) {
+        this->watching = true;
+        this->head = state.pc;
+        this->sp = state.sp;
+        this->interrupts_enabled = state.interrupts.enabled;
+        memcpy(this->registers, state.registers, sizeof(this->registers));
+        this->flags_pending = state.flags_pending;
+        this->pending_flags_opcode = state.pending_flags_opcode;
+        this->pending_flags_operands = state.pending_flags_operands;
+        this->time = now;
+        this->instructions = state.instructions_executed;
+	return 0;
+    }
+
+    uint64_t iteration = now - this->time;
+    uint32_t instructions = state.instructions_executed - this->instructions;
+    this->time = now;
+    this->instructions = state.instructions_executed;
+    this->checks++;
+    IdleLoop& loop = this->find_loop(state, state.pc);
+    if (!loop.idle || branch_pc < state.pc || branch_pc > loop.end || iteration == 0) {
+        return 0;
+    }
+
+    /* The last iteration read the same values throughout, and so will the
+     * skipped ones if they end before anything it read changes */
+    uint64_t limit = deadline;
+    for (const IdleLoopRead& read : loop.reads) {
+        limit = min(limit, state.next_change(read_address(state, read), now - iteration));
+    }
+    uint64_t skipped = limit > now ? (limit - now) / iteration : 0;
+    if (skipped == 0) {
+        return 0;
+    }
+
+    state.instructions_executed += skipped * instructions;
+    this->instructions = state.instructions_executed;
+    this->time += skipped * iteration;
+    this->skips++;
+    this->skipped_cycles += skipped * iteration;
+    loop.skips++;
+    loop.skipped_cycles += skipped * iteration;
+    return skipped * iteration;
+}
+
+void IdleLoopDetector::report(ostream& out, uint64_t total_cycles) const
+{
+    uint32_t idle = 0;
+    for (const auto& entry : this->loops) {
+        idle += entry.second.idle;
+    }
+    out << dec << "Idle loops: " << idle << " of " << this->loops.size() << " repeating loops idle, "
+        << this->skips << " skips in " << this->checks << " repeated iterations, "
+        << this->skipped_cycles * 100 / (total_cycles == 0 ? 1 : total_cycles) << "% of cycles skipped.\n";
+    for (const auto& entry : this->loops) {
+        const IdleLoop& loop = entry.second;
+        if (loop.skips != 0) {
+            out << "  bank " << (entry.first >> 16) << " " << hex << (entry.first & 0xffff) << "-" << loop.end
+	        << dec << ": " << loop.skips << " skips, "
+		<< loop.skipped_cycles * 100 / (total_cycles == 0 ? 1 : total_cycles) << "% of cycles\n";
+	}
+    }
+}
+
+IdleLoop& IdleLoopDetector::find_loop(State& state, uint16_t head)
+{
+    uint32_t key = (code_bank(state, head) << 16) | head;
+    auto found = this->loops.find(key);
+    if (found != this->loops.end()) {
+        return found->second;
+    }
+    IdleLoop& loop = this->loops[key];
+    this->analyse_loop(state, head, loop);
+    return loop;
+}
+
+void IdleLoopDetector::analyse_loop(State& state, uint16_t head, IdleLoop& loop)
+{
+    loop = IdleLoop{false, head, {}, 0, 0};
+    /* Code outside ROM can change under the loop */
+    if (head > 0x7fff) {
+        return;
+    }
+
+    uint16_t region_end = code_region_end(head);
+    uint16_t pc = head;
+    while (pc - head < MAX_IDLE_LOOP_BYTES) {
+        OpCode op_code{};
+        uint16_t opcode = fetch_op(state, pc, op_code);
+	const Instruction& instruction = decode_instruction(opcode);
+	uint16_t next = pc + (opcode >= 0x100 ? 2 : instruction.bytes);
+	if (next - 1 > region_end) {
+	    return;
+	}
+
+	if (instruction.function == &JR || instruction.function == &JP) {
+	    /* JP (HL) goes somewhere unknown */
+	    if (instruction.operand1.kind == OperandKind::MEM_REGISTER_PAIR) {
+	        return;
+	    }
+	    uint16_t target = instruction.function == &JR ? next + static_cast<int8_t>(op_code[1])
+	                                                  : op_code[1] | (op_code[2] << 8);
+	    if (target == head) {
+	        loop.idle = true;
+		loop.end = pc;
+		return;
+	    }
+	    /* Forward branches skip ahead or leave the loop. Coming back from
+	     * outside shows up as a branch from outside the body. */
+	    if (target < next || instruction.operand_count == 1) {
+	        return;
+	    }
+	} else if (!only_reads(instruction)) {
+	    return;
+	}
+
+	for (const Operand& operand : {instruction.operand1, instruction.operand2}) {
+	    if (reads_memory(operand)) {
+	        uint16_t addr = operand.kind == OperandKind::MEM_A8 ? 0xff00 + op_code[1] : op_code[1] | (op_code[2] << 8);
+	        loop.reads.push_back(IdleLoopRead{operand.kind, operand.value, addr});
+	    }
+	}
+	pc = next;
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "instruction.h"
+#include "state.h"
+
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/* Backward branches at most this far can close an idle loop */
+const std::uint16_t MAX_IDLE_LOOP_BYTES = 32;
+
+/* A memory read of an idle loop. Reads through a register pair or C get
+ * their address from the registers when the loop is checked. */
+typedef struct IdleLoopRead {
+    OperandKind kind;
+    std::uint8_t value;
+    std::uint16_t addr;
+} IdleLoopRead;
+
+/* A loop in ROM that writes nothing but registers and flags. idle is false
+ * when the loop does anything else. */
+typedef struct IdleLoop {
+    bool idle;
+    std::uint16_t end;
+    std::vector<IdleLoopRead> reads;
+    std::uint64_t skips;
+    std::uint64_t skipped_cycles;
+} IdleLoop;
+
+/* Finds busy-wait loops: short loops that only read memory they do not write.
+ * When one iteration of such a loop leaves the CPU exactly as it found it, so
+ * will every following one, until an event or interrupt changes what the
+ * loop reads. Those iterations can be skipped whole. */
+class IdleLoopDetector {
+public:
+    /* Called when the CPU branched back from branch_pc to state.pc. Returns
+     * the machine cycles of the iterations that can be skipped, all of which
+     * end by deadline. The caller adds them to the clock. */
+    std::uint64_t check(State& state, std::uint16_t branch_pc, std::uint64_t deadline);
+    /* Forgets the iteration being watched. Called whenever something other
+     * than the CPU may have changed memory. */
+    void reset() {this->watching = false;}
+    /* Prints the loops found and the share of cycles skipped in them */
+    void report(std::ostream& out, std::uint64_t total_cycles) const;
+
+    std::uint64_t checks = 0;
+    std::uint64_t skips = 0;
+    std::uint64_t skipped_cycles = 0;
+private:
+    IdleLoop& find_loop(State& state, std::uint16_t head);
+    void analyse_loop(State& state, std::uint16_t head, IdleLoop& loop);
+
+    std::unordered_map<std::uint32_t, IdleLoop> loops;
+
+    /* The CPU state when the loop head was last reached */
+    bool watching = false;
+    std::uint8_t registers[8];
+    bool flags_pending = false;
+    std::uint16_t pending_flags_opcode = 0;
+    std::pair<std::uint16_t, std::uint16_t> pending_flags_operands = {0, 0};
+    std::uint16_t sp = 0;
+    std::uint16_t head = 0;
+    bool interrupts_enabled = false;
+    std::uint64_t time = 0;
+    std::uint32_t instructions = 0;
+};
@@ -0,0 +1,76 @@
+#include "input.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using std::cout;
+using std::getline;
+using std::ifstream;
+using std::istringstream;
+using std::size_t;
+using std::string;
+using std::uint8_t;
+using std::uint64_t;
+
+static const char* const BUTTON_NAMES[8] = {"right", "left", "up", "down", "a", "b", "select", "start"};
+
+bool InputScript::load(const string& filename)
+{
+    ifstream file(filename);
+    if (!file) {
+        cout << "[WARNING]: Could not open input script " << filename << ".\n";
+        return false;
+    }
+
+    this->steps.clear();
+    this->next = 0;
+    string line;
+    size_t line_number = 0;
+    while (getline(file, line)) {
+        line_number++;
+        line = line.substr(0, line.find('#'));
+        istringstream words(line);
+        uint64_t frame = 0;
+        if (!(words >> frame)) {
+            if (line.find_first_not_of(" \t\r") == string::npos) {
+                continue;
+            }
+            cout << "[WARNING]: Input script line " << line_number << " does not start with a frame.\n";
+            return false;
+        }
+
+        uint8_t buttons = 0xff;
+        string name;
+        while (words >> name) {
+            size_t button = 0;
+            while (button < 8 && name != BUTTON_NAMES[button]) {
+                button++;
+            }
+            if (button == 8) {
+                cout << "[WARNING]: Unknown button " << name << " on input script line " << line_number << ".\n";
+                return false;
+            }
+            buttons &= ~(1 << button);
+        }
+        if (!this->steps.empty() && frame < this->steps.back().first) {
+            cout << "[WARNING]: Input script line " << line_number << " goes back in time.\n";
+            return false;
+        }
+        this->steps.emplace_back(frame, buttons);
+    }
+    return true;
+}
+
+void InputScript::play(uint64_t frame, Joypad& joypad)
+{
+    while (this->next < this->steps.size() && this->steps[this->next].first <= frame) {
+        joypad.set(this->steps[this->next].second);
+        this->next++;
+    }
+}
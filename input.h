@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Joypad buttons by their bit in State::set_buttons() */
+enum class Button : std::uint8_t {
+    RIGHT,
+    LEFT,
+    UP,
+    DOWN,
+    A,
+    B,
+    SELECT,
+    START
+};
+
+/* The buttons held by the player, active low. Input sources on any thread
+ * press and release them; the emulation thread hands them to the machine
+ * with State::set_buttons() between time slices. */
+class Joypad {
+public:
+    void press(Button button)
+    {
+        this->held.fetch_and(~(1 << static_cast<std::uint8_t>(button)), std::memory_order_relaxed);
+    }
+    void release(Button button)
+    {
+        this->held.fetch_or(1 << static_cast<std::uint8_t>(button), std::memory_order_relaxed);
+    }
+    void set(std::uint8_t buttons) {this->held.store(buttons, std::memory_order_relaxed);}
+    std::uint8_t buttons() const {return this->held.load(std::memory_order_relaxed);}
+private:
+    std::atomic<std::uint8_t> held{0xff};
+};
+
+/* Input played back from a file, for runs without a window. Each line is a
+ * frame number followed by the names of the buttons held from that frame on
+ * (right, left, up, down, a, b, select, start); a line with no names releases
+ * everything. Lines must be in frame order, and # starts a comment. */
+class InputScript {
+public:
+    bool load(const std::string& filename);
+    /* Sets the buttons of the last line due by frame */
+    void play(std::uint64_t frame, Joypad& joypad);
+private:
+    std::vector<std::pair<std::uint64_t, std::uint8_t>> steps;
+    std::size_t next = 0;
+};
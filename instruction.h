@@ -1,23 +1,75 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
-#include <string>
-#include <vector>
-
-enum class FlagEffect {
-    APPLY = 0,
-    IGNORE,
-    SET,
-    CLEAR
+#include <utility>
+
+class State;
+
+const std::uint8_t FLAG_Z = 0x80;
+const std::uint8_t FLAG_N = 0x40;
+const std::uint8_t FLAG_H = 0x20;
+const std::uint8_t FLAG_C = 0x10;
+
+enum Register : std::uint8_t {
+    REG_B = 0, REG_C, REG_D, REG_E, REG_H, REG_L, REG_A, REG_F
+};
+
+/* Register pair n consists of registers 2n (high) and 2n + 1 (low). */
+enum RegisterPair : std::uint8_t {
+    PAIR_BC = 0, PAIR_DE, PAIR_HL, PAIR_AF
+};
+
+enum Condition : std::uint8_t {
+    COND_NZ = 0, COND_Z, COND_NC, COND_C
 };
 
+enum class OperandKind : std::uint8_t {
+    NONE = 0,
+    REGISTER,
+    REGISTER_PAIR,
+    SP,
+    D8,
+    D16,
+    A16,
+    R8,
+    SP_R8,
+    LITERAL,
+    CONDITION,
+    MEM_REGISTER_PAIR,
+    MEM_HL_INC,
+    MEM_HL_DEC,
+    MEM_A8,
+    MEM_A16,
+    MEM_C
+};
+
+/* Operands are decoded by helper.py. The value is the register, register pair
+ * or condition index, or the number itself for literals (RST vectors, bit indices). */
+typedef struct Operand {
+    OperandKind kind;
+    std::uint8_t value;
+    const char* name;
+} Operand;
+
+struct Instruction;
+
+/* Instruction bytes as fetched: the opcode (0xcb for prefixed ops) and up to two operand bytes. */
+typedef std::array<std::uint8_t, 3> OpCode;
+
+typedef std::pair<std::uint16_t, std::uint16_t> (*OpFunction)(State&, const Instruction&, const OpCode&);
+
+/* Flag effects are packed as FLAG_* bit masks. Flags in none of the masks are left unchanged. */
 typedef struct Instruction {
-    std::string name;
-    std::uint32_t bytes;
-    std::uint32_t operand_count;
-    std::string operand1;
-    std::string operand2;
-    std::uint32_t cycles;
-    std::uint32_t branch_cycles;
-    std::vector<FlagEffect> flags_ZNHC;
+    const char* name;
+    OpFunction function;
+    std::uint8_t bytes;
+    std::uint8_t operand_count;
+    Operand operand1;
+    Operand operand2;
+    std::uint8_t cycles;
+    std::uint8_t branch_cycles;
+    std::uint8_t flags_apply;
+    std::uint8_t flags_set;
+    std::uint8_t flags_clear;
 } Instruction;
@@ -0,0 +1,47 @@
+#include "interrupts.h"
+#include "snapshot.h"
+
+#include <cstdint>
+
+using std::uint8_t;
+using std::uint16_t;
+using std::uint32_t;
+
+uint16_t InterruptController::take(uint32_t instructions)
+{
+    if (!this->enabled || this->pending == 0) {
+        return 0;
+    } else if (this->delayed && instructions == this->ei_done_at) {
+        return 0;
+    }
+    this->delayed = false;
+
+    /* Lower bits go first */
+    uint8_t bit = 0;
+    while (!(this->pending & (1 << bit))) {
+        bit++;
+    }
+    this->enabled = false;
+    this->write_if(this->interrupt_flags & ~(1 << bit));
+    return 0x40 + 0x8 * bit;
+}
+
+void InterruptController::save_state(SnapshotWriter& writer) const
+{
+    writer.put(this->interrupt_flags);
+    writer.put(this->interrupt_enable);
+    writer.put(this->enabled);
+    writer.put(this->halted);
+    writer.put(this->delayed);
+    writer.put(this->ei_done_at);
+}
+
+bool InterruptController::load_state(SnapshotReader& reader)
+{
+    if (!reader.get(this->interrupt_flags) || !reader.get(this->interrupt_enable) || !reader.get(this->enabled)
+        || !reader.get(this->halted) || !reader.get(this->delayed) || !reader.get(this->ei_done_at)) {
+        return false;
+    }
+    this->pending = this->interrupt_flags & this->interrupt_enable & 0x1f;
+    return true;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "snapshot.h"
+
+#include <cstdint>
+
+/* IF and IE, IME and HALT. The interrupts that are both requested and
+ * enabled are kept in pending on every write, so the check between
+ * instructions is a test of one byte, and a nonzero pending is also what
+ * ends HALT. */
+class InterruptController {
+public:
+    std::uint8_t read_if() const {return this->interrupt_flags;}
+    std::uint8_t read_ie() const {return this->interrupt_enable;}
+    void write_if(std::uint8_t value)
+    {
+        this->interrupt_flags = value;
+        this->update();
+    }
+    void write_ie(std::uint8_t value)
+    {
+        this->interrupt_enable = value;
+        this->update();
+    }
+    void request(std::uint8_t mask) {this->write_if(this->interrupt_flags | mask);}
+
+    /* EI takes effect after the instruction following it. instructions is
+     * the count before EI itself is counted. */
+    void enable_after(std::uint32_t instructions)
+    {
+        this->enabled = true;
+        this->delayed = true;
+        this->ei_done_at = instructions + 1;
+    }
+    void enable()
+    {
+        this->enabled = true;
+        this->delayed = false;
+    }
+    void disable() {this->enabled = false;}
+    /* HALT does not stop a CPU that already has an interrupt to wake it */
+    void halt() {this->halted = this->pending == 0;}
+    /* Acknowledges the highest priority pending interrupt and returns its
+     * handler address, or 0 while IME is off or EI is still delayed. */
+    std::uint16_t take(std::uint32_t instructions);
+
+    void save_state(SnapshotWriter& writer) const;
+    bool load_state(SnapshotReader& reader);
+
+    /* IF & IE & 0x1f */
+    std::uint8_t pending = 0;
+    /* IME */
+    bool enabled = false;
+    bool halted = false;
+private:
+    void update()
+    {
+        this->pending = this->interrupt_flags & this->interrupt_enable & 0x1f;
+        if (this->pending != 0) {
+            this->halted = false;
+        }
+    }
+
+    std::uint8_t interrupt_flags = 0;
+    std::uint8_t interrupt_enable = 0;
+    /* While delayed, no interrupt is taken at the count EI finished at */
+    bool delayed = false;
+    std::uint32_t ei_done_at = 0;
+};
@@ -0,0 +1,902 @@
+#include "jit.h"
+#include "block_cache.h"
+#include "instruction.h"
+#include "op_table.h"
+#include "ops.h"
+#include "state.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <sys/mman.h>
+#define JIT_SUPPORTED
+#endif
+
+using std::copy;
+using std::cout;
+using std::dec;
+using std::hex;
+using std::map;
+using std::max;
+using std::memcpy;
+using std::ostringstream;
+using std::pair;
+using std::size_t;
+using std::string;
+using std::vector;
+using std::int8_t;
+using std::int32_t;
+using std::uint8_t;
+using std::uint16_t;
+using std::uint32_t;
+using std::uint64_t;
+
+Jit::Jit()
+{
+#ifdef JIT_SUPPORTED
+    void* buffer = mmap(nullptr, JIT_CODE_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffer == MAP_FAILED) {
+        cout << "[WARNING]: Could not map JIT code buffer, using the interpreter.\n";
+    } else {
+        this->code_buffer = static_cast<uint8_t*>(buffer);
+    }
+#endif
+}
+
+Jit::~Jit()
+{
+#ifdef JIT_SUPPORTED
+    if (this->code_buffer != nullptr) {
+        munmap(this->code_buffer, JIT_CODE_SIZE);
+    }
+#endif
+}
+
+#ifdef JIT_SUPPORTED
+
+/* SM83 registers live in callee saved host registers while a block runs:
+ * rbx holds the State pointer, rbp holds F, r12-r14 hold BC, DE and HL as
+ * 16-bit values and r15 holds A. SP stays in State. eax, ecx, edx, esi and
+ * edi are scratch. The cycle count of helper calls is summed in [rsp]. */
+enum HostRegister : uint8_t {
+    RAX = 0, RCX, RDX, RBX, RSP, RBP, RSI, RDI,
+    R8, R9, R10, R11, R12, R13, R14, R15
+};
+
+const uint8_t HOST_A = R15;
+const uint8_t HOST_F = RBP;
+const uint8_t HOST_STATE = RBX;
+
+enum Jcc : uint8_t {
+    JB = 0x82, JE = 0x84, JNE = 0x85
+};
+
+enum AluOp : uint8_t {
+    ALU_ADD = 0, ALU_OR = 1, ALU_AND = 4, ALU_SUB = 5, ALU_XOR = 6, ALU_CMP = 7
+};
+
+static uint8_t jit_read_memory(State* state, uint16_t addr)
+{
+    return state->read_memory(addr);
+}
+
+static void jit_write_memory(State* state, uint16_t addr, uint8_t value)
+{
+    state->write_memory(addr, value);
+}
+
+/* Instructions without a native translation run through the interpreter with the
+ * registers spilled to State. Flags are evaluated so F can be reloaded. */
+static uint32_t jit_execute_op(State* state, uint16_t opcode, const OpCode* op_code)
+{
+    uint32_t cycles = execute_decoded_op(*state, opcode, *op_code);
+    evaluate_flags(*state);
+    return cycles;
+}
+
+static int32_t field_offset(State& state, const void* field)
+{
+    return static_cast<const uint8_t*>(field) - reinterpret_cast<const uint8_t*>(&state);
+}
+
+class Assembler {
+public:
+    vector<uint8_t> code;
+
+    void byte(uint8_t value) {code.push_back(value);}
+    void imm16(uint16_t value) {byte(value & 0xff); byte(value >> 8);}
+    void imm32(uint32_t value) {imm16(value & 0xffff); imm16(value >> 16);}
+    void imm64(uint64_t value) {imm32(value & 0xffffffff); imm32(value >> 32);}
+
+    void rex(bool wide, uint8_t reg, uint8_t rm)
+    {
+        uint8_t prefix = 0x40 | (wide ? 8 : 0) | ((reg & 8) ? 4 : 0) | ((rm & 8) ? 1 : 0);
+        if (prefix != 0x40) {byte(prefix);}
+    }
+
+    /* op reg, rm with both operands in registers */
+    void reg_reg(uint8_t opcode, uint8_t reg, uint8_t rm, bool wide = false)
+    {
+        rex(wide, reg, rm);
+        byte(opcode);
+        byte(0xc0 | (reg & 7) << 3 | (rm & 7));
+    }
+
+    /* op reg, [rbx + disp] */
+    void reg_state(uint8_t opcode, uint8_t reg, int32_t disp)
+    {
+        rex(false, reg, HOST_STATE);
+        byte(opcode);
+        byte(0x80 | (reg & 7) << 3 | HOST_STATE);
+        imm32(disp);
+    }
+
+    void mov(uint8_t dst, uint8_t src) {reg_reg(0x89, src, dst);}
+    void mov_imm(uint8_t dst, uint32_t value) {rex(false, 0, dst); byte(0xb8 | (dst & 7)); imm32(value);}
+    void mov64(uint8_t dst, uint64_t value) {rex(true, 0, dst); byte(0xb8 | (dst & 7)); imm64(value);}
+    void or_reg(uint8_t dst, uint8_t src) {reg_reg(0x09, src, dst);}
+    void alu(AluOp op, uint8_t dst, uint32_t value) {reg_reg(0x81, op, dst); imm32(value);}
+    void shl(uint8_t dst, uint8_t count) {reg_reg(0xc1, 4, dst); byte(count);}
+    void shr(uint8_t dst, uint8_t count) {reg_reg(0xc1, 5, dst); byte(count);}
+    void test(uint8_t dst, uint32_t value) {reg_reg(0xf7, 0, dst); imm32(value);}
+
+    void movzx8(uint8_t dst, uint8_t src)
+    {
+        rex(false, dst, src);
+        byte(0x0f);
+        byte(0xb6);
+        byte(0xc0 | (dst & 7) << 3 | (src & 7));
+    }
+
+    void load8(uint8_t dst, int32_t disp) {rex(false, dst, HOST_STATE); byte(0x0f); reg_state_tail(0xb6, dst, disp);}
+    void load16(uint8_t dst, int32_t disp) {rex(false, dst, HOST_STATE); byte(0x0f); reg_state_tail(0xb7, dst, disp);}
+    void store8(int32_t disp, uint8_t src) {reg_state(0x88, src, disp);}
+    void store16(int32_t disp, uint8_t src) {byte(0x66); reg_state(0x89, src, disp);}
+    void store16_imm(int32_t disp, uint16_t value) {byte(0x66); reg_state(0xc7, 0, disp); imm16(value);}
+    void add32(int32_t disp, uint32_t value) {reg_state(0x81, ALU_ADD, disp); imm32(value);}
+
+    /* 8-bit ALU op al, cl */
+    void alu_al_cl(AluOp op) {byte(op << 3); byte(0xc8);}
+    void inc_al() {byte(0xfe); byte(0xc0);}
+    void dec_al() {byte(0xfe); byte(0xc8);}
+    /* lahf; movzx ecx, ah */
+    void host_flags_to_ecx() {byte(0x9f); byte(0x0f); byte(0xb6); byte(0xcc);}
+
+    /* cmp byte [rbx + rax + disp], 0 */
+    void cmp_state_table(int32_t disp) {byte(0x80); byte(0xbc); byte(0x03); imm32(disp); byte(0);}
+
+    void zero_cycle_slot() {byte(0xc7); byte(0x04); byte(0x24); imm32(0);}
+    void add_cycle_slot(uint32_t value) {byte(0x81); byte(0x04); byte(0x24); imm32(value);}
+    void add_cycle_slot_eax() {byte(0x01); byte(0x04); byte(0x24);}
+    void load_cycle_slot_eax() {byte(0x8b); byte(0x04); byte(0x24);}
+
+    void call(const void* function)
+    {
+        reg_reg(0x89, HOST_STATE, RDI, true);
+        mov64(RAX, reinterpret_cast<uint64_t>(function));
+        byte(0xff);
+        byte(0xd0);
+    }
+
+    void push(uint8_t reg) {rex(false, 0, reg); byte(0x50 | (reg & 7));}
+    void pop(uint8_t reg) {rex(false, 0, reg); byte(0x58 | (reg & 7));}
+
+    int new_label()
+    {
+        labels.push_back(-1);
+        return labels.size() - 1;
+    }
+
+    void bind(int label) {labels[label] = code.size();}
+
+    void jump(int label) {byte(0xe9); patch(label);}
+    void jump(Jcc condition, int label) {byte(0x0f); byte(condition); patch(label);}
+
+    void resolve_labels()
+    {
+        for (auto fixup : fixups) {
+            int32_t rel = labels[fixup.second] - (int32_t) (fixup.first + 4);
+            memcpy(&code[fixup.first], &rel, 4);
+        }
+    }
+private:
+    vector<int32_t> labels;
+    vector<pair<size_t, int>> fixups;
+
+    void reg_state_tail(uint8_t opcode, uint8_t reg, int32_t disp)
+    {
+        byte(opcode);
+        byte(0x80 | (reg & 7) << 3 | HOST_STATE);
+        imm32(disp);
+    }
+
+    void patch(int label)
+    {
+        fixups.emplace_back(code.size(), label);
+        imm32(0);
+    }
+};
+
+/* Where an exit stub leaves the block. A stub without a PC is used after
+ * instructions that set it themselves. */
+typedef struct JitExit {
+    int label;
+    bool set_pc;
+    uint16_t pc;
+    uint32_t native_ops;
+    uint32_t cycles;
+} JitExit;
+
+enum class JitAccess {
+    NONE, READ, WRITE
+};
+
+class BlockCompiler {
+public:
+    BlockCompiler(State& state)
+    {
+        this->offset_a = field_offset(state, &state.registers[REG_A]);
+        this->offset_f = field_offset(state, &state.registers[REG_F]);
+        this->offset_sp = field_offset(state, &state.sp);
+        this->offset_pc = field_offset(state, &state.pc);
+        this->offset_instructions = field_offset(state, &state.instructions_executed);
+        this->offset_code_lines = field_offset(state, &state.code_lines);
+        for (uint8_t i = REG_B; i <= REG_L; i++) {
+            this->offset_registers[i] = field_offset(state, &state.registers[i]);
+        }
+    }
+
+    /* worst_cycles is what the compiled code can report at most */
+    bool compile(const Block& block, vector<uint8_t>& out, uint32_t& worst_cycles);
+private:
+    Assembler as;
+    vector<JitExit> exits;
+    int epilogue = 0;
+    uint32_t native_ops = 0;
+    uint32_t cycles = 0;
+
+    int32_t offset_a, offset_f, offset_sp, offset_pc;
+    int32_t offset_instructions, offset_code_lines;
+    int32_t offset_registers[6];
+
+    int exit_to(bool set_pc, uint16_t pc, uint32_t native_ops, uint32_t cycles)
+    {
+        int label = as.new_label();
+        exits.push_back({label, set_pc, pc, native_ops, cycles});
+        return label;
+    }
+
+    static uint8_t pair_host(uint8_t pair) {return R12 + pair;}
+
+    void load_register(uint8_t reg, uint8_t dst);
+    void store_register(uint8_t reg, uint8_t src);
+    void spill();
+    void reload();
+    bool constant_address(const Operand& operand, const OpCode& op_code, uint16_t& addr);
+    bool address_supported(const Operand& operand, const OpCode& op_code);
+    void emit_address(const Operand& operand, const OpCode& op_code);
+    void emit_check(JitAccess access, int bail);
+    void emit_hl_update(const Operand& operand);
+    void emit_flags(const Instruction& instruction);
+    void emit_read(const Operand& operand, const OpCode& op_code, int bail, uint8_t dst);
+    bool emit_native(const CachedOp& op, const Instruction& instruction, int bail, bool& ends);
+    bool emit_interpreted(const CachedOp& op, const Instruction& instruction, int bail, bool& ends);
+};
+
+void BlockCompiler::load_register(uint8_t reg, uint8_t dst)
+{
+    if (reg == REG_A) {
+        as.mov(dst, HOST_A);
+    } else if (reg % 2 == 0) {
+        as.mov(dst, pair_host(reg / 2));
+        as.shr(dst, 8);
+    } else {
+        as.movzx8(dst, pair_host(reg / 2));
+    }
+}
+
+/* src must hold a zero extended byte. It is clobbered. */
+void BlockCompiler::store_register(uint8_t reg, uint8_t src)
+{
+    if (reg == REG_A) {
+        as.mov(HOST_A, src);
+    } else if (reg % 2 == 0) {
+        as.alu(ALU_AND, pair_host(reg / 2), 0xff);
+        as.shl(src, 8);
+        as.or_reg(pair_host(reg / 2), src);
+    } else {
+        as.alu(ALU_AND, pair_host(reg / 2), 0xff00);
+        as.or_reg(pair_host(reg / 2), src);
+    }
+}
+
+void BlockCompiler::spill()
+{
+    as.mov(RAX, HOST_A);
+    as.store8(offset_a, RAX);
+    as.mov(RAX, HOST_F);
+    as.store8(offset_f, RAX);
+    for (uint8_t pair = PAIR_BC; pair <= PAIR_HL; pair++) {
+        as.mov(RAX, pair_host(pair));
+        as.store8(offset_registers[pair * 2 + 1], RAX);
+        as.shr(RAX, 8);
+        as.store8(offset_registers[pair * 2], RAX);
+    }
+}
+
+void BlockCompiler::reload()
+{
+    as.load8(HOST_A, offset_a);
+    as.load8(HOST_F, offset_f);
+    for (uint8_t pair = PAIR_BC; pair <= PAIR_HL; pair++) {
+        as.load8(RAX, offset_registers[pair * 2]);
+        as.shl(RAX, 8);
+        as.load8(RCX, offset_registers[pair * 2 + 1]);
+        as.or_reg(RAX, RCX);
+        as.mov(pair_host(pair), RAX);
+    }
+}
+
+bool BlockCompiler::constant_address(const Operand& operand, const OpCode& op_code, uint16_t& addr)
+{
+    if (operand.kind == OperandKind::MEM_A8) {
+        addr = uint8_to_uint16(0xff, op_code[1]);
+        return true;
+    } else if (operand.kind == OperandKind::MEM_A16) {
+        addr = uint8_to_uint16(op_code[2], op_code[1]);
+        return true;
+    }
+    return false;
+}
+
+/* I/O registers are never touched from native code. An instruction that always
+ * accesses them ends the block so the interpreter runs it in step with the PPU. */
+bool BlockCompiler::address_supported(const Operand& operand, const OpCode& op_code)
+{
+    uint16_t addr = 0;
+    if (!constant_address(operand, op_code, addr)) {
+        return true;
+    }
+    return !((addr >= 0xff00 && addr <= 0xff7f) || addr == 0xffff);
+}
+
+/* Leaves the address of a memory operand in esi. */
+void BlockCompiler::emit_address(const Operand& operand, const OpCode& op_code)
+{
+    uint16_t addr = 0;
+    if (constant_address(operand, op_code, addr)) {
+        as.mov_imm(RSI, (uint32_t) addr);
+    } else if (operand.kind == OperandKind::MEM_C) {
+        load_register(REG_C, RSI);
+        as.alu(ALU_OR, RSI, 0xff00);
+    } else if (operand.kind == OperandKind::MEM_REGISTER_PAIR) {
+        as.mov(RSI, pair_host(operand.value));
+    } else {
+        as.mov(RSI, pair_host(PAIR_HL));
+    }
+}
+
+/* Bails out before accessing I/O registers, and before writes that could switch
+ * banks or modify code the block caches have decoded. */
+void BlockCompiler::emit_check(JitAccess access, int bail)
+{
+    as.mov(RAX, RSI);
+    as.alu(ALU_AND, RAX, 0xff80);
+    as.alu(ALU_CMP, RAX, 0xff00);
+    as.jump(JE, bail);
+    as.alu(ALU_CMP, RSI, 0xffff);
+    as.jump(JE, bail);
+    if (access == JitAccess::WRITE) {
+        as.alu(ALU_CMP, RSI, 0x8000);
+        as.jump(JB, bail);
+        as.mov(RAX, RSI);
+        as.shr(RAX, 6);
+        as.cmp_state_table(offset_code_lines);
+        as.jump(JNE, bail);
+    }
+}
+
+void BlockCompiler::emit_hl_update(const Operand& operand)
+{
+    if (operand.kind == OperandKind::MEM_HL_INC) {
+        as.alu(ALU_ADD, pair_host(PAIR_HL), 1);
+        as.alu(ALU_AND, pair_host(PAIR_HL), 0xffff);
+    } else if (operand.kind == OperandKind::MEM_HL_DEC) {
+        as.alu(ALU_SUB, pair_host(PAIR_HL), 1);
+        as.alu(ALU_AND, pair_host(PAIR_HL), 0xffff);
+    }
+}
+
+/* ecx holds the host flags from lahf: ZF in bit 6, AF in bit 4 and CF in bit 0.
+ * x86 computes the half carry from bit 3 the same way the SM83 does. */
+void BlockCompiler::emit_flags(const Instruction& instruction)
+{
+    uint8_t affected = instruction.flags_apply | instruction.flags_set | instruction.flags_clear;
+    if (instruction.flags_apply != 0) {
+        as.mov(RDX, RCX);
+        as.shl(RCX, 1);
+        as.alu(ALU_AND, RCX, FLAG_Z | FLAG_H);
+        as.alu(ALU_AND, RDX, 1);
+        as.shl(RDX, 4);
+        as.or_reg(RCX, RDX);
+        as.alu(ALU_AND, RCX, instruction.flags_apply);
+    }
+    if (affected != 0) {
+        as.alu(ALU_AND, HOST_F, ~affected & 0xff);
+    }
+    if (instruction.flags_apply != 0) {
+        as.or_reg(HOST_F, RCX);
+    }
+    if (instruction.flags_set != 0) {
+        as.alu(ALU_OR, HOST_F, instruction.flags_set);
+    }
+}
+
+/* Loads a register, immediate or memory operand into dst. */
+void BlockCompiler::emit_read(const Operand& operand, const OpCode& op_code, int bail, uint8_t dst)
+{
+    if (operand.kind == OperandKind::REGISTER) {
+        load_register(operand.value, dst);
+    } else if (operand.kind == OperandKind::D8) {
+        as.mov_imm(dst, (uint32_t) op_code[1]);
+    } else {
+        emit_address(operand, op_code);
+        emit_check(JitAccess::READ, bail);
+        emit_hl_update(operand);
+        as.call(reinterpret_cast<const void*>(&jit_read_memory));
+        as.movzx8(dst, RAX);
+    }
+}
+
+static bool memory_operand(const Operand& operand)
+{
+    return operand.kind >= OperandKind::MEM_REGISTER_PAIR;
+}
+
+static bool simple_operand(const Operand& operand)
+{
+    return operand.kind == OperandKind::REGISTER || operand.kind == OperandKind::D8
+        || memory_operand(operand);
+}
+
+bool BlockCompiler::emit_native(const CachedOp& op, const Instruction& instruction, int bail, bool& ends)
+{
+    const Operand& operand1 = instruction.operand1;
+    const Operand& operand2 = instruction.operand2;
+    const OpCode& op_code = op.op_code;
+    OpFunction function = instruction.function;
+    uint16_t next_pc = op.addr + instruction.bytes;
+
+    if (function == &NOP || function == &CPL) {
+        if (function == &CPL) {
+            as.alu(ALU_XOR, HOST_A, 0xff);
+        }
+        emit_flags(instruction);
+    } else if (function == &CCF) {
+        as.alu(ALU_XOR, HOST_F, FLAG_C);
+        as.alu(ALU_AND, HOST_F, ~instruction.flags_clear & 0xff);
+    } else if (function == &LD && operand1.kind == OperandKind::REGISTER && simple_operand(operand2)) {
+        emit_read(operand2, op_code, bail, RAX);
+        store_register(operand1.value, RAX);
+    } else if (function == &LD && memory_operand(operand1)
+               && (operand2.kind == OperandKind::REGISTER || operand2.kind == OperandKind::D8)) {
+        emit_address(operand1, op_code);
+        emit_check(JitAccess::WRITE, bail);
+        emit_hl_update(operand1);
+        if (operand2.kind == OperandKind::REGISTER) {
+            load_register(operand2.value, RDX);
+        } else {
+            as.mov_imm(RDX, (uint32_t) op_code[1]);
+        }
+        as.call(reinterpret_cast<const void*>(&jit_write_memory));
+    } else if (function == &LD && operand1.kind == OperandKind::REGISTER_PAIR && operand2.kind == OperandKind::D16) {
+        as.mov_imm(pair_host(operand1.value), (uint32_t) uint8_to_uint16(op_code[2], op_code[1]));
+    } else if (function == &LD && operand1.kind == OperandKind::SP && operand2.kind == OperandKind::D16) {
+        as.store16_imm(offset_sp, uint8_to_uint16(op_code[2], op_code[1]));
+    } else if (function == &LD && operand1.kind == OperandKind::SP && operand2.kind == OperandKind::REGISTER_PAIR) {
+        as.store16(offset_sp, pair_host(PAIR_HL));
+    } else if ((function == &INC || function == &DEC) && operand1.kind == OperandKind::REGISTER) {
+        load_register(operand1.value, RAX);
+        if (function == &INC) {
+            as.inc_al();
+        } else {
+            as.dec_al();
+        }
+        as.host_flags_to_ecx();
+        as.movzx8(RAX, RAX);
+        store_register(operand1.value, RAX);
+        emit_flags(instruction);
+    } else if ((function == &INC || function == &DEC) && operand1.kind == OperandKind::REGISTER_PAIR) {
+        as.alu(function == &INC ? ALU_ADD : ALU_SUB, pair_host(operand1.value), 1);
+        as.alu(ALU_AND, pair_host(operand1.value), 0xffff);
+    } else if ((function == &ADD && operand1.kind == OperandKind::REGISTER && simple_operand(operand2))
+               || ((function == &SUB || function == &AND || function == &XOR || function == &OR || function == &CP)
+                   && simple_operand(operand1))) {
+        AluOp alu_op = ALU_ADD;
+        if (function == &SUB) {alu_op = ALU_SUB;}
+        if (function == &AND) {alu_op = ALU_AND;}
+        if (function == &XOR) {alu_op = ALU_XOR;}
+        if (function == &OR) {alu_op = ALU_OR;}
+        if (function == &CP) {alu_op = ALU_CMP;}
+
+        emit_read(function == &ADD ? operand2 : operand1, op_code, bail, RCX);
+        as.mov(RAX, HOST_A);
+        as.alu_al_cl(alu_op);
+        as.host_flags_to_ecx();
+        if (function != &CP) {
+            as.movzx8(HOST_A, RAX);
+        }
+        emit_flags(instruction);
+    } else if ((function == &JR || function == &JP) && operand1.kind != OperandKind::MEM_REGISTER_PAIR) {
+        bool conditional = operand1.kind == OperandKind::CONDITION;
+        uint16_t target = 0;
+        if (function == &JR) {
+            target = next_pc + (int8_t) op_code[1];
+        } else {
+            target = uint8_to_uint16(op_code[2], op_code[1]);
+        }
+        uint32_t taken_cycles = instruction.cycles;
+        if (target != next_pc && instruction.branch_cycles != 0) {
+            taken_cycles = instruction.branch_cycles;
+        }
+
+        if (conditional) {
+            uint8_t mask = (operand1.value == COND_NZ || operand1.value == COND_Z) ? FLAG_Z : FLAG_C;
+            bool jump_if_set = operand1.value == COND_Z || operand1.value == COND_C;
+            as.test(HOST_F, mask);
+            as.jump(jump_if_set ? JE : JNE,
+                    exit_to(true, next_pc, native_ops + 1, cycles + instruction.cycles));
+        }
+        as.jump(exit_to(true, target, native_ops + 1, cycles + taken_cycles));
+        ends = true;
+    } else if (function == &JP) { /* JP (HL) */
+        as.store16(offset_pc, pair_host(PAIR_HL));
+        as.jump(exit_to(false, 0, native_ops + 1, cycles + instruction.cycles));
+        ends = true;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/* Runs one instruction through execute_decoded_op. Memory it touches is checked
+ * first, like in native code. */
+bool BlockCompiler::emit_interpreted(const CachedOp& op, const Instruction& instruction, int bail, bool& ends)
+{
+    OpFunction function = instruction.function;
+    const Operand& operand1 = instruction.operand1;
+    const Operand& operand2 = instruction.operand2;
+
+    if (function == &EI || function == &DI || function == &RETI || function == &HALT
+        || function == &STOP || invalid_ops.find(op.op_code[0]) != invalid_ops.end()) {
+        /* These change interrupt or CPU mode state the main loop checks after every call. */
+        return false;
+    }
+
+    if (function == &LD && operand2.kind == OperandKind::SP) { /* LD (a16), SP */
+        uint16_t addr = uint8_to_uint16(op.op_code[2], op.op_code[1]);
+        as.mov_imm(RSI, (uint32_t) addr);
+        emit_check(JitAccess::WRITE, bail);
+        as.mov_imm(RSI, (uint32_t) (uint16_t) (addr + 1));
+        emit_check(JitAccess::WRITE, bail);
+    } else if (function == &PUSH || function == &CALL || function == &RST) {
+        as.load16(RSI, offset_sp);
+        for (int i = 0; i < 2; i++) {
+            as.alu(ALU_SUB, RSI, 1);
+            as.alu(ALU_AND, RSI, 0xffff);
+            emit_check(JitAccess::WRITE, bail);
+        }
+    } else if (function == &POP || function == &RET) {
+        as.load16(RSI, offset_sp);
+        emit_check(JitAccess::READ, bail);
+        as.alu(ALU_ADD, RSI, 1);
+        as.alu(ALU_AND, RSI, 0xffff);
+        emit_check(JitAccess::READ, bail);
+    } else if (memory_operand(operand1) || memory_operand(operand2)) {
+        const Operand& operand = memory_operand(operand1) ? operand1 : operand2;
+        bool writes = function != &BIT && function != &ADC && function != &SBC;
+        emit_address(operand, op.op_code);
+        emit_check(writes ? JitAccess::WRITE : JitAccess::READ, bail);
+    }
+
+    spill();
+    as.store16_imm(offset_pc, op.addr);
+    as.mov_imm(RSI, (uint32_t) op.opcode);
+    as.mov64(RDX, reinterpret_cast<uint64_t>(&op.op_code));
+    as.call(reinterpret_cast<const void*>(&jit_execute_op));
+    as.add_cycle_slot_eax();
+    reload();
+
+    if (ends_block(instruction)) {
+        as.jump(exit_to(false, 0, native_ops, cycles));
+        ends = true;
+    }
+    return true;
+}
+
+bool BlockCompiler::compile(const Block& block, vector<uint8_t>& out, uint32_t& worst_cycles)
+{
+    epilogue = as.new_label();
+    as.push(RBX);
+    as.push(RBP);
+    as.push(R12);
+    as.push(R13);
+    as.push(R14);
+    as.push(R15);
+    as.reg_reg(0x83, 5, RSP, true); /* sub rsp, 8 keeps the stack 16-byte aligned for calls */
+    as.byte(8);
+    as.zero_cycle_slot();
+    as.reg_reg(0x89, RDI, HOST_STATE, true);
+    reload();
+
+    uint32_t budget = 0;
+    uint16_t pc = block.ops[0].addr;
+    bool ends = false;
+    size_t compiled = 0;
+    for (const CachedOp& op : block.ops) {
+        const Instruction& instruction = decode_instruction(op.opcode);
+        uint32_t worst_cycles = max(instruction.cycles, instruction.branch_cycles);
+        if (budget + worst_cycles > JIT_MAX_BLOCK_CYCLES
+            || !address_supported(instruction.operand1, op.op_code)
+            || !address_supported(instruction.operand2, op.op_code)) {
+            break;
+        }
+
+        int bail = exit_to(true, op.addr, native_ops, cycles);
+        size_t start = as.code.size();
+        if (emit_native(op, instruction, bail, ends)) {
+            native_ops++;
+            cycles += instruction.cycles;
+        } else if (!emit_interpreted(op, instruction, bail, ends)) {
+            as.code.resize(start);
+            exits.pop_back();
+            break;
+        }
+        budget += worst_cycles;
+        pc = op.addr + instruction.bytes;
+        compiled++;
+        if (ends) {
+            break;
+        }
+    }
+    if (compiled == 0) {
+        return false;
+    }
+    worst_cycles = budget;
+    if (!ends) {
+        as.jump(exit_to(true, pc, native_ops, cycles));
+    }
+
+    for (const JitExit& exit : exits) {
+        as.bind(exit.label);
+        if (exit.set_pc) {
+            as.store16_imm(offset_pc, exit.pc);
+        }
+        if (exit.native_ops != 0) {
+            as.add32(offset_instructions, exit.native_ops);
+        }
+        if (exit.cycles != 0) {
+            as.add_cycle_slot(exit.cycles);
+        }
+        as.jump(epilogue);
+    }
+
+    as.bind(epilogue);
+    spill();
+    as.load_cycle_slot_eax();
+    as.reg_reg(0x83, 0, RSP, true); /* add rsp, 8 */
+    as.byte(8);
+    as.pop(R15);
+    as.pop(R14);
+    as.pop(R13);
+    as.pop(R12);
+    as.pop(RBP);
+    as.pop(RBX);
+    as.byte(0xc3);
+
+    as.resolve_labels();
+    out.swap(as.code);
+    return true;
+}
+
+JitFunction Jit::compile(State& state, const Block& block, uint32_t& worst_cycles)
+{
+    if (this->code_buffer == nullptr) {
+        return nullptr;
+    }
+
+    BlockCompiler compiler(state);
+    vector<uint8_t> code;
+    if (!compiler.compile(block, code, worst_cycles)) {
+        return nullptr;
+    }
+
+    if (this->code_used + code.size() > JIT_CODE_SIZE) {
+        /* Start over once the buffer is full */
+        this->blocks.clear();
+        this->code_used = 0;
+    }
+    uint8_t* dest = this->code_buffer + this->code_used;
+    copy(code.begin(), code.end(), dest);
+    this->code_used += (code.size() + 15) & ~15;
+    return reinterpret_cast<JitFunction>(dest);
+}
+
+#else
+
+JitFunction Jit::compile(State& state, const Block& block, uint32_t& worst_cycles)
+{
+    return nullptr;
+}
+
+#endif
+
+uint32_t Jit::run(State& state)
+{
+    if (this->diverged) {
+        return execute_op(state);
+    }
+
+    Block* block = this->decoder.find_block(state, state.pc);
+    if (block == nullptr) {
+        return execute_op(state);
+    }
+
+    auto it = this->blocks.find(block);
+    if (it == this->blocks.end() || it->second.generation != block->generation) {
+        /* Compiling may flush the map, so look the entry up again afterwards */
+        uint32_t worst_cycles = 0;
+        JitFunction code = this->compile(state, *block, worst_cycles);
+        it = this->blocks.insert_or_assign(block, JitBlock{block->generation, code, worst_cycles}).first;
+    }
+    JitFunction code = it->second.code;
+    if (code == nullptr) {
+        return execute_op(state);
+    }
+    /* Near a deadline, step up to it one instruction at a time */
+    uint64_t now = state.scheduler.now;
+    uint64_t deadline = state.scheduler.next_deadline();
+    if (deadline <= now || (deadline - now) * 4 < it->second.worst_cycles) {
+        return execute_op(state);
+    }
+
+    evaluate_flags(state);
+    uint32_t cycles = this->differential ? this->run_differential(state, code) : code(&state);
+    return cycles != 0 ? cycles : execute_op(state);
+}
+
+typedef struct CpuSnapshot {
+    uint8_t registers[8];
+    uint16_t sp;
+    uint16_t pc;
+    uint32_t instructions_executed;
+    uint32_t stack_depth;
+    bool save_pending;
+} CpuSnapshot;
+
+static CpuSnapshot take_snapshot(State& state)
+{
+    CpuSnapshot snapshot;
+    evaluate_flags(state);
+    for (uint8_t i = REG_B; i <= REG_F; i++) {
+        snapshot.registers[i] = state.registers[i];
+    }
+    snapshot.sp = state.sp;
+    snapshot.pc = state.pc;
+    snapshot.instructions_executed = state.instructions_executed;
+    snapshot.stack_depth = state.stack_depth;
+    snapshot.save_pending = state.save_pending;
+    return snapshot;
+}
+
+static void restore_snapshot(State& state, const CpuSnapshot& snapshot)
+{
+    for (uint8_t i = REG_B; i <= REG_F; i++) {
+        state.registers[i] = snapshot.registers[i];
+    }
+    state.flags_pending = false;
+    state.sp = snapshot.sp;
+    state.pc = snapshot.pc;
+    state.instructions_executed = snapshot.instructions_executed;
+    state.stack_depth = snapshot.stack_depth;
+    state.save_pending = snapshot.save_pending;
+}
+
+/* Runs the block natively, undoes its memory writes and runs the same number of
+ * instructions in the interpreter. The interpreter's result is kept. */
+uint32_t Jit::run_differential(State& state, JitFunction code)
+{
+    const char* register_names[8] = {"B", "C", "D", "E", "H", "L", "A", "F"};
+    CpuSnapshot before = take_snapshot(state);
+    vector<pair<uint16_t, uint8_t>> jit_writes;
+    state.write_log = &jit_writes;
+    uint32_t jit_cycles = code(&state);
+    state.write_log = nullptr;
+    if (jit_cycles == 0) {
+        return 0;
+    }
+
+    CpuSnapshot jit_result = take_snapshot(state);
+    map<uint16_t, uint8_t> jit_memory;
+    for (auto write : jit_writes) {
+        jit_memory[write.first] = state.read_memory(write.first);
+    }
+    for (auto it = jit_writes.rbegin(); it != jit_writes.rend(); it++) {
+        state.write_memory(it->first, it->second);
+    }
+    restore_snapshot(state, before);
+
+    vector<pair<uint16_t, uint8_t>> interpreter_writes;
+    uint32_t cycles = 0;
+    state.write_log = &interpreter_writes;
+    while (state.instructions_executed != jit_result.instructions_executed) {
+        cycles += execute_op(state);
+    }
+    state.write_log = nullptr;
+    CpuSnapshot result = take_snapshot(state);
+
+    for (auto write : interpreter_writes) {
+        jit_memory.insert(write);
+    }
+
+    vector<string> mismatches;
+    auto compare = [&mismatches](string name, uint32_t expected, uint32_t actual) {
+        if (expected != actual) {
+            ostringstream message;
+            message << name << " " << hex << actual << " (interpreter " << expected << ")";
+            mismatches.push_back(message.str());
+        }
+    };
+    for (uint8_t i = REG_B; i <= REG_F; i++) {
+        compare(register_names[i], result.registers[i], jit_result.registers[i]);
+    }
+    compare("SP", result.sp, jit_result.sp);
+    compare("PC", result.pc, jit_result.pc);
+    compare("stack depth", result.stack_depth, jit_result.stack_depth);
+    compare("cycles", cycles, jit_cycles);
+    for (auto value : jit_memory) {
+        ostringstream name;
+        name << "[" << hex << value.first << "]";
+        compare(name.str(), state.read_memory(value.first), value.second);
+    }
+
+    if (!mismatches.empty()) {
+        cout << "[WARNING]: JIT diverged from the interpreter in the block at "
+             << hex << before.pc << " after " << dec
+             << result.instructions_executed - before.instructions_executed << " instructions:\n";
+        for (const string& mismatch : mismatches) {
+            cout << "    " << mismatch << "\n";
+        }
+        cout << "[WARNING]: Continuing with the interpreter only.\n";
+        this->diverged = true;
+    }
+    return cycles;
+}
+
+uint32_t execute_jit_op(State& state)
+{
+    if (state.jit == nullptr) {
+        state.jit = new Jit();
+    }
+    return state.jit->run(state);
+}
+
+uint32_t execute_jit_diff_op(State& state)
+{
+    if (state.jit == nullptr) {
+        state.jit = new Jit();
+        state.jit->differential = true;
+    }
+    return state.jit->run(state);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "block_cache.h"
+#include "instruction.h"
+#include "state.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+/* A compiled block returns the cycles it ran for and leaves state.pc at the
+ * first instruction it did not run. It returns 0 if it bailed out before
+ * running anything. */
+typedef std::uint32_t (*JitFunction)(State* state);
+
+typedef struct JitBlock {
+    std::uint32_t generation;
+    JitFunction code;
+    /* The most cycles the block can report, taking every branch */
+    std::uint32_t worst_cycles;
+} JitBlock;
+
+/* Upper bound on the cycles a single call may report. Jit::run() only enters
+ * a block whose worst case fits before scheduler.next_deadline() and runs
+ * single instructions in the interpreter otherwise, so like the interpreter
+ * it passes a deadline by at most one instruction. The bound keeps blocks
+ * short enough that this rarely falls back, and below one scanline
+ * (456 cycles) between line events. */
+const std::uint32_t JIT_MAX_BLOCK_CYCLES = 128;
+const std::size_t JIT_CODE_SIZE = 16 << 20;
+
+class Jit {
+public:
+    Jit();
+    ~Jit();
+    std::uint32_t run(State& state);
+
+    /* Run every block a second time in the interpreter and report the first mismatch. */
+    bool differential = false;
+    bool diverged = false;
+private:
+    JitFunction compile(State& state, const Block& block, std::uint32_t& worst_cycles);
+    std::uint32_t run_differential(State& state, JitFunction code);
+
+    BlockCache decoder;
+    std::unordered_map<const Block*, JitBlock> blocks;
+    std::uint8_t* code_buffer = nullptr;
+    std::size_t code_used = 0;
+};
+
+std::uint32_t execute_jit_op(State& state);
+std::uint32_t execute_jit_diff_op(State& state);
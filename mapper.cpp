@@ -0,0 +1,545 @@
+#include "mapper.h"
+#include "saver.h"
+#include "snapshot.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using std::copy_n;
+using std::cout;
+using std::equal;
+using std::hex;
+using std::int32_t;
+using std::int64_t;
+using std::max;
+using std::min;
+using std::size_t;
+using std::string;
+using std::time;
+using std::time_t;
+using std::uint8_t;
+using std::uint16_t;
+using std::uint32_t;
+using std::uint64_t;
+using std::vector;
+
+const uint32_t RTC_DAY_SECONDS = 24 * 60 * 60;
+const uint32_t RTC_PERIOD_SECONDS = 512 * RTC_DAY_SECONDS;
+
+Mapper::Mapper(uint16_t rom_banks, uint32_t ram_size) : ram_size(ram_size),
+                                                        rom_banks(rom_banks),
+                                                        ram_banks(max<uint32_t>(ram_size / 0x2000, 1))
+{
+    if (ram_size != 0) {
+        this->ram = new uint8_t[max<uint32_t>(ram_size, 0x2000)]{0};
+    }
+}
+
+Mapper::~Mapper()
+{
+    /* The footer can no longer be built here, see State::~State() */
+    if (this->save_file != nullptr) {
+        delete this->save_file;
+    } else {
+        delete[] this->ram;
+    }
+}
+
+uint8_t Mapper::read_ram(uint16_t addr)
+{
+    return 0xff;
+}
+
+vector<uint8_t> Mapper::save_data()
+{
+    vector<uint8_t> data;
+    if (this->ram != nullptr) {
+        data.assign(this->ram, this->ram + this->ram_size);
+    }
+    vector<uint8_t> footer = this->save_footer();
+    data.insert(data.end(), footer.begin(), footer.end());
+    return data;
+}
+
+void Mapper::load_save_data(const vector<uint8_t>& data)
+{
+    if (this->ram != nullptr) {
+        copy_n(data.begin(), min<size_t>(data.size(), this->ram_size), this->ram);
+    }
+    if (data.size() > this->ram_size) {
+        this->load_save_footer(data.data() + this->ram_size, data.size() - this->ram_size);
+    }
+}
+
+vector<uint8_t> Mapper::save_footer()
+{
+    return vector<uint8_t>();
+}
+
+void Mapper::load_save_footer(const uint8_t* footer, size_t size)
+{
+}
+
+bool Mapper::map_save_file(const string& filename)
+{
+    this->save_file = new MappedSaveFile();
+    vector<uint8_t> footer;
+    if (!this->save_file->open(filename, this->ram_size, max<uint32_t>(this->ram_size, 0x2000), footer)) {
+        delete this->save_file;
+        this->save_file = nullptr;
+        return false;
+    }
+    if (!footer.empty()) {
+        this->load_save_footer(footer.data(), footer.size());
+    }
+
+    if (this->ram != nullptr) {
+        if (this->ram_window != nullptr) {
+            this->ram_window = this->save_file->data + (this->ram_window - this->ram);
+        }
+        delete[] this->ram;
+        this->ram = this->save_file->data;
+    }
+    return true;
+}
+
+void Mapper::sync_save_file(bool wait)
+{
+    if (this->save_file != nullptr) {
+        this->save_file->sync(this->save_footer(), wait);
+    }
+}
+
+void Mapper::save_state(SnapshotWriter& writer, bool include_ram)
+{
+    int32_t window = this->ram_window != nullptr ? this->ram_window - this->ram : -1;
+    writer.put(this->rom_bank_low);
+    writer.put(this->rom_bank_high);
+    writer.put(window);
+    writer.put(this->ram_size);
+    if (include_ram && this->ram != nullptr) {
+        writer.put_bytes(this->ram, this->ram_size);
+    }
+}
+
+bool Mapper::load_state(SnapshotReader& reader, bool include_ram)
+{
+    uint16_t low = 0;
+    uint16_t high = 0;
+    int32_t window = 0;
+    uint32_t size = 0;
+    if (!reader.get(low) || !reader.get(high) || !reader.get(window) || !reader.get(size)
+        || low >= this->rom_banks || high >= this->rom_banks || size != this->ram_size
+        || (window >= 0 && (this->ram == nullptr || static_cast<uint32_t>(window) >= this->ram_banks * 0x2000))) {
+        return false;
+    }
+    if (include_ram && this->ram != nullptr && !reader.get_bytes(this->ram, this->ram_size)) {
+        return false;
+    }
+    this->rom_bank_low = low;
+    this->rom_bank_high = high;
+    this->ram_window = window >= 0 ? this->ram + window : nullptr;
+    return true;
+}
+
+void Mapper::map_rom(uint32_t low, uint32_t high)
+{
+    this->rom_bank_low = low % this->rom_banks;
+    this->rom_bank_high = high % this->rom_banks;
+}
+
+void Mapper::map_ram(bool enabled, uint32_t bank)
+{
+    if (enabled && this->ram != nullptr) {
+        this->ram_window = this->ram + 0x2000 * (bank % this->ram_banks);
+    } else {
+        this->ram_window = nullptr;
+    }
+}
+
+RomOnly::RomOnly(uint16_t rom_banks, uint32_t ram_size) : Mapper(rom_banks, ram_size)
+{
+    this->map_rom(0, 1);
+    this->map_ram(true, 0);
+}
+
+bool RomOnly::write(uint16_t addr, uint8_t value)
+{
+    if (this->ram_window != nullptr && addr >= 0xa000 && addr <= 0xbfff) {
+        this->ram_window[addr - 0xa000] = value;
+	return true;
+    }
+    return false;
+}
+
+Mbc1::Mbc1(uint16_t rom_banks, uint32_t ram_size, bool multicart) : Mapper(rom_banks, ram_size),
+                                                                    multicart(multicart)
+{
+    this->update_banks();
+}
+
+bool Mbc1::write(uint16_t addr, uint8_t value)
+{
+    if (addr <= 0x1fff) {
+        this->ram_enabled = (value & 0xf) == 0xa;
+    } else if (addr <= 0x3fff) {
+        this->bank1 = value & 0x1f;
+	if (this->bank1 == 0) {this->bank1 = 1;}
+    } else if (addr <= 0x5fff) {
+        this->bank2 = value & 0x3;
+    } else if (addr <= 0x7fff) {
+        this->banking_mode = (value & 0x1) != 0;
+    } else if (this->ram_window != nullptr) {
+        this->ram_window[addr - 0xa000] = value;
+	return true;
+    }
+    this->update_banks();
+    return false;
+}
+
+void Mbc1::update_banks()
+{
+    /* In mode 1 the upper register also switches the bank at 0x0000 and the RAM bank */
+    uint32_t upper = this->bank2 << (this->multicart ? 4 : 5);
+    uint32_t lower = this->multicart ? (this->bank1 & 0xf) : this->bank1;
+    this->map_rom(this->banking_mode ? upper : 0, upper | lower);
+    this->map_ram(this->ram_enabled, this->banking_mode ? this->bank2 : 0);
+}
+
+void Mbc1::save_state(SnapshotWriter& writer, bool include_ram)
+{
+    Mapper::save_state(writer, include_ram);
+    writer.put(this->ram_enabled);
+    writer.put(this->banking_mode);
+    writer.put(this->bank1);
+    writer.put(this->bank2);
+}
+
+bool Mbc1::load_state(SnapshotReader& reader, bool include_ram)
+{
+    return Mapper::load_state(reader, include_ram) && reader.get(this->ram_enabled) && reader.get(this->banking_mode)
+           && reader.get(this->bank1) && reader.get(this->bank2);
+}
+
+Mbc2::Mbc2(uint16_t rom_banks) : Mapper(rom_banks, 0x200)
+{
+    this->map_rom(0, 1);
+}
+
+bool Mbc2::write(uint16_t addr, uint8_t value)
+{
+    /* Address bit 8 selects between the RAM enable and the ROM bank register */
+    if (addr <= 0x3fff && (addr & 0x100)) {
+        value &= 0xf;
+	this->map_rom(0, value == 0 ? 1 : value);
+    } else if (addr <= 0x3fff) {
+        this->ram_enabled = (value & 0xf) == 0xa;
+    } else if (this->ram_enabled && addr >= 0xa000 && addr <= 0xbfff) {
+        this->ram[addr & 0x1ff] = value & 0xf;
+	return true;
+    }
+    return false;
+}
+
+uint8_t Mbc2::read_ram(uint16_t addr)
+{
+    if (!this->ram_enabled) {
+        return 0xff;
+    }
+    return 0xf0 | this->ram[addr & 0x1ff];
+}
+
+void Mbc2::save_state(SnapshotWriter& writer, bool include_ram)
+{
+    Mapper::save_state(writer, include_ram);
+    writer.put(this->ram_enabled);
+}
+
+bool Mbc2::load_state(SnapshotReader& reader, bool include_ram)
+{
+    return Mapper::load_state(reader, include_ram) && reader.get(this->ram_enabled);
+}
+
+Mbc3::Mbc3(uint16_t rom_banks, uint32_t ram_size, bool has_rtc) : Mapper(rom_banks, ram_size),
+                                                                  has_rtc(has_rtc)
+{
+    /* Without a saved clock, count from the start of the current 512-day
+     * period so the time of day still survives restarts. */
+    time_t now = time(0);
+    this->rtc_base = now - now % RTC_PERIOD_SECONDS;
+    this->update_banks();
+}
+
+bool Mbc3::write(uint16_t addr, uint8_t value)
+{
+    if (addr <= 0x1fff) {
+        this->ram_enabled = (value & 0xf) == 0xa;
+    } else if (addr <= 0x3fff) {
+        value &= 0x7f;
+	this->map_rom(0, value == 0 ? 1 : value);
+    } else if (addr <= 0x5fff) {
+        this->ram_bank = value & 0xf;
+    } else if (addr <= 0x7fff) {
+        if (this->has_rtc && this->prev_rtc_latch == 0 && value == 1) {
+            this->latch_rtc();
+	}
+	this->prev_rtc_latch = value;
+    } else if (this->ram_window != nullptr) {
+        this->ram_window[addr - 0xa000] = value;
+	return true;
+    } else if (this->ram_enabled && this->has_rtc && this->ram_bank >= 0x8 && this->ram_bank <= 0xc) {
+        this->write_rtc(this->ram_bank - 0x8, value);
+	return true;
+    }
+    this->update_banks();
+    return false;
+}
+
+uint8_t Mbc3::read_ram(uint16_t addr)
+{
+    if (this->ram_enabled && this->has_rtc && this->ram_bank >= 0x8 && this->ram_bank <= 0xc) {
+        return this->rtc_latched[this->ram_bank - 0x8];
+    }
+    return 0xff;
+}
+
+void Mbc3::update_banks()
+{
+    this->map_ram(this->ram_enabled && this->ram_bank <= 0x3, this->ram_bank);
+}
+
+uint32_t Mbc3::rtc_counter()
+{
+    uint32_t counter = this->rtc_halted_counter;
+    if (!this->rtc_halted) {
+        time_t elapsed = time(0) - this->rtc_base;
+	counter = elapsed > 0 ? static_cast<uint32_t>(elapsed) : 0;
+    }
+    if (counter >= RTC_PERIOD_SECONDS) {
+        this->rtc_carry = true;
+	counter %= RTC_PERIOD_SECONDS;
+	this->set_rtc_counter(counter);
+    }
+    return counter;
+}
+
+void Mbc3::set_rtc_counter(uint32_t counter)
+{
+    if (this->rtc_halted) {
+        this->rtc_halted_counter = counter;
+    } else {
+        this->rtc_base = time(0) - counter;
+    }
+}
+
+void Mbc3::latch_rtc()
+{
+    uint32_t counter = this->rtc_counter();
+    uint32_t days = counter / RTC_DAY_SECONDS;
+    this->rtc_latched[0] = counter % 60;
+    this->rtc_latched[1] = counter / 60 % 60;
+    this->rtc_latched[2] = counter / 3600 % 24;
+    this->rtc_latched[3] = days & 0xff;
+    this->rtc_latched[4] = ((days >> 8) & 0x1) | (this->rtc_halted ? 0x40 : 0) | (this->rtc_carry ? 0x80 : 0);
+}
+
+void Mbc3::write_rtc(uint8_t reg, uint8_t value)
+{
+    uint32_t counter = this->rtc_counter();
+    uint32_t seconds = counter % 60;
+    uint32_t minutes = counter / 60 % 60;
+    uint32_t hours = counter / 3600 % 24;
+    uint32_t days = counter / RTC_DAY_SECONDS;
+
+    switch (reg) {
+    case 0: seconds = value & 0x3f; break;
+    case 1: minutes = value & 0x3f; break;
+    case 2: hours = value & 0x1f; break;
+    case 3: days = (days & 0x100) | value; break;
+    case 4:
+        days = (days & 0xff) | ((value & 0x1) << 8);
+	this->rtc_halted = (value & 0x40) != 0;
+	this->rtc_carry = (value & 0x80) != 0;
+	value &= 0xc1;
+	break;
+    }
+
+    this->set_rtc_counter(((days * 24 + hours) * 60 + minutes) * 60 + seconds);
+    this->rtc_latched[reg] = value;
+}
+
+static void append_le(vector<uint8_t>& data, uint64_t value, uint8_t bytes)
+{
+    for (uint8_t i = 0; i < bytes; i++) {
+        data.push_back((value >> (8 * i)) & 0xff);
+    }
+}
+
+static uint64_t read_le(const uint8_t* data, uint8_t bytes)
+{
+    uint64_t value = 0;
+    for (uint8_t i = 0; i < bytes; i++) {
+        value |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+vector<uint8_t> Mbc3::save_footer()
+{
+    vector<uint8_t> data;
+    if (!this->has_rtc) {
+        return data;
+    }
+
+    uint32_t counter = this->rtc_counter();
+    uint32_t days = counter / RTC_DAY_SECONDS;
+    uint8_t current[5] = {
+        static_cast<uint8_t>(counter % 60),
+        static_cast<uint8_t>(counter / 60 % 60),
+        static_cast<uint8_t>(counter / 3600 % 24),
+        static_cast<uint8_t>(days & 0xff),
+        static_cast<uint8_t>(((days >> 8) & 0x1) | (this->rtc_halted ? 0x40 : 0) | (this->rtc_carry ? 0x80 : 0))
+    };
+    for (uint8_t reg : current) {
+        append_le(data, reg, 4);
+    }
+    for (uint8_t reg : this->rtc_latched) {
+        append_le(data, reg, 4);
+    }
+    append_le(data, time(0), 8);
+    return data;
+}
+
+void Mbc3::load_save_footer(const uint8_t* rtc, size_t rtc_size)
+{
+    /* Some emulators store the time as 32 bits, giving 44 bytes */
+    if (!this->has_rtc || (rtc_size != 44 && rtc_size != 48)) {
+        return;
+    }
+
+    uint8_t current[5];
+    for (uint8_t i = 0; i < 5; i++) {
+        current[i] = read_le(rtc + 4 * i, 4);
+        this->rtc_latched[i] = read_le(rtc + 20 + 4 * i, 4);
+    }
+    time_t saved_at = read_le(rtc + 40, rtc_size - 40);
+
+    uint32_t days = current[3] | ((current[4] & 0x1) << 8);
+    uint32_t counter = ((days * 24 + current[2] % 24) * 60 + current[1] % 60) * 60 + current[0] % 60;
+    this->rtc_halted = (current[4] & 0x40) != 0;
+    this->rtc_carry = (current[4] & 0x80) != 0;
+    this->set_rtc_counter(counter);
+    if (!this->rtc_halted && time(0) > saved_at) {
+        this->rtc_base -= time(0) - saved_at;
+    }
+}
+
+/* The clock keeps counting wall time from the saved base like it does
+ * between sessions with save files. */
+void Mbc3::save_state(SnapshotWriter& writer, bool include_ram)
+{
+    Mapper::save_state(writer, include_ram);
+    writer.put(this->ram_enabled);
+    writer.put(this->ram_bank);
+    writer.put(this->prev_rtc_latch);
+    writer.put(static_cast<int64_t>(this->rtc_base));
+    writer.put(this->rtc_halted_counter);
+    writer.put(this->rtc_halted);
+    writer.put(this->rtc_carry);
+    writer.put(this->rtc_latched);
+}
+
+bool Mbc3::load_state(SnapshotReader& reader, bool include_ram)
+{
+    int64_t rtc_base = 0;
+    bool loaded = Mapper::load_state(reader, include_ram) && reader.get(this->ram_enabled) && reader.get(this->ram_bank)
+                  && reader.get(this->prev_rtc_latch) && reader.get(rtc_base) && reader.get(this->rtc_halted_counter)
+                  && reader.get(this->rtc_halted) && reader.get(this->rtc_carry) && reader.get(this->rtc_latched);
+    this->rtc_base = rtc_base;
+    return loaded;
+}
+
+Mbc5::Mbc5(uint16_t rom_banks, uint32_t ram_size, bool has_rumble) : Mapper(rom_banks, ram_size),
+                                                                    has_rumble(has_rumble)
+{
+    this->update_banks();
+}
+
+bool Mbc5::write(uint16_t addr, uint8_t value)
+{
+    if (addr <= 0x1fff) {
+        this->ram_enabled = value == 0xa;
+    } else if (addr <= 0x2fff) {
+        this->rom_bank = (this->rom_bank & 0x100) | value;
+    } else if (addr <= 0x3fff) {
+        this->rom_bank = (this->rom_bank & 0xff) | ((value & 0x1) << 8);
+    } else if (addr <= 0x5fff) {
+        /* Rumble cartridges drive the motor with bit 3 of the RAM bank register */
+        if (this->has_rumble) {
+            this->motor_on = (value & 0x8) != 0;
+	    value &= 0x7;
+	}
+        this->ram_bank = value & 0xf;
+    } else if (addr <= 0x7fff) {
+        return false;
+    } else if (this->ram_window != nullptr) {
+        this->ram_window[addr - 0xa000] = value;
+	return true;
+    }
+    this->update_banks();
+    return false;
+}
+
+void Mbc5::update_banks()
+{
+    this->map_rom(0, this->rom_bank);
+    this->map_ram(this->ram_enabled, this->ram_bank);
+}
+
+void Mbc5::save_state(SnapshotWriter& writer, bool include_ram)
+{
+    Mapper::save_state(writer, include_ram);
+    writer.put(this->motor_on);
+    writer.put(this->ram_enabled);
+    writer.put(this->rom_bank);
+    writer.put(this->ram_bank);
+}
+
+bool Mbc5::load_state(SnapshotReader& reader, bool include_ram)
+{
+    return Mapper::load_state(reader, include_ram) && reader.get(this->motor_on) && reader.get(this->ram_enabled)
+           && reader.get(this->rom_bank) && reader.get(this->ram_bank);
+}
+
+Mapper* create_mapper(const uint8_t* rom, uint16_t rom_banks)
+{
+    uint32_t ram_size = 0;
+    switch (rom[0x149]) {
+    case 0x01: ram_size = 0x800; break;
+    case 0x02: ram_size = 0x2000; break;
+    case 0x03: ram_size = 0x8000; break;
+    case 0x04: ram_size = 0x20000; break;
+    case 0x05: ram_size = 0x10000; break;
+    }
+
+    uint8_t type = rom[0x147];
+    if (type >= 0x01 && type <= 0x03) {
+        /* Multicarts repeat the Nintendo logo at the start of each 256 KiB game */
+        bool multicart = rom_banks == 64 && equal(rom + 0x104, rom + 0x134, rom + 0x40104);
+        return new Mbc1(rom_banks, ram_size, multicart);
+    } else if (type == 0x05 || type == 0x06) {
+        return new Mbc2(rom_banks);
+    } else if (type >= 0x0f && type <= 0x13) {
+        return new Mbc3(rom_banks, ram_size, type == 0x0f || type == 0x10);
+    } else if (type >= 0x19 && type <= 0x1e) {
+        return new Mbc5(rom_banks, ram_size, type >= 0x1c);
+    } else if (type != 0x00 && type != 0x08 && type != 0x09) {
+        cout << "[WARNING]: Unsupported cartridge type " << hex << (uint16_t) type << ".\n";
+    }
+    return new RomOnly(rom_banks, ram_size);
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+class MappedSaveFile;
+class SnapshotReader;
+class SnapshotWriter;
+
+/* Cartridge memory bank controller. A mapper owns its bank registers, the
+ * external RAM and any RTC. It publishes the banks it currently maps so State
+ * can put them in its page table and only calls back into the mapper for
+ * control writes and for RAM reads with side effects. */
+class Mapper {
+public:
+    Mapper(std::uint16_t rom_banks, std::uint32_t ram_size);
+    virtual ~Mapper();
+    Mapper(const Mapper& mapper) = delete;
+    Mapper& operator=(const Mapper& mapper) = delete;
+
+    /* Handles a write to 0x0000-0x7fff or 0xa000-0xbfff. Returns true when
+     * battery-backed state changed and the save file needs to be written. */
+    virtual bool write(std::uint16_t addr, std::uint8_t value) = 0;
+    /* Handles a read from 0xa000-0xbfff while ram_window is null. */
+    virtual std::uint8_t read_ram(std::uint16_t addr);
+    virtual bool rumble() const {return false;}
+
+    /* Battery-backed state in save file format: the RAM, followed by a
+     * mapper specific footer such as the RTC. */
+    std::vector<std::uint8_t> save_data();
+    void load_save_data(const std::vector<std::uint8_t>& data);
+    virtual std::vector<std::uint8_t> save_footer();
+    virtual void load_save_footer(const std::uint8_t* footer, std::size_t size);
+
+    /* Replaces the RAM with a shared mapping of the save file, creating it if
+     * needed, so RAM writes reach the file without copies. The footer is read
+     * from the file now and written back by sync_save_file(). */
+    bool map_save_file(const std::string& filename);
+    /* Starts writing back the mapped save file, or with wait, finishes it. */
+    void sync_save_file(bool wait);
+
+    /* Registers and RAM for save states. Subclasses append their own
+     * registers to the base class state. State::fork() keeps the RAM itself
+     * and leaves it out. */
+    virtual void save_state(SnapshotWriter& writer, bool include_ram);
+    virtual bool load_state(SnapshotReader& reader, bool include_ram);
+
+    /* ROM banks mapped at 0x0000-0x3fff and 0x4000-0x7fff, and the 8 KiB of
+     * external RAM mapped at 0xa000-0xbfff if reading it is side-effect free. */
+    std::uint16_t rom_bank_low = 0;
+    std::uint16_t rom_bank_high = 1;
+    std::uint8_t* ram_window = nullptr;
+
+    /* Battery-backed RAM as stored in the save file. The buffer is padded to
+     * at least one full 8 KiB bank. */
+    std::uint8_t* ram = nullptr;
+    std::uint32_t ram_size = 0;
+protected:
+    /* Bank numbers wrap around like the unconnected address lines would. */
+    void map_rom(std::uint32_t low, std::uint32_t high);
+    void map_ram(bool enabled, std::uint32_t bank);
+
+    std::uint16_t rom_banks;
+    std::uint32_t ram_banks;
+    MappedSaveFile* save_file = nullptr;
+};
+
+/* Cartridges without a controller, optionally with up to 8 KiB of RAM. */
+class RomOnly : public Mapper {
+public:
+    RomOnly(std::uint16_t rom_banks, std::uint32_t ram_size);
+    bool write(std::uint16_t addr, std::uint8_t value) override;
+};
+
+class Mbc1 : public Mapper {
+public:
+    /* Multicarts wire the upper bank register to ROM address lines 18-19
+     * instead of 19-20, so each game sees 16 banks. */
+    Mbc1(std::uint16_t rom_banks, std::uint32_t ram_size, bool multicart);
+    bool write(std::uint16_t addr, std::uint8_t value) override;
+    void save_state(SnapshotWriter& writer, bool include_ram) override;
+    bool load_state(SnapshotReader& reader, bool include_ram) override;
+private:
+    void update_banks();
+
+    bool multicart;
+    bool ram_enabled = false;
+    bool banking_mode = false;
+    std::uint8_t bank1 = 1;
+    std::uint8_t bank2 = 0;
+};
+
+/* 512 half-bytes of built-in RAM, mirrored across 0xa000-0xbfff. */
+class Mbc2 : public Mapper {
+public:
+    Mbc2(std::uint16_t rom_banks);
+    bool write(std::uint16_t addr, std::uint8_t value) override;
+    std::uint8_t read_ram(std::uint16_t addr) override;
+    void save_state(SnapshotWriter& writer, bool include_ram) override;
+    bool load_state(SnapshotReader& reader, bool include_ram) override;
+private:
+    bool ram_enabled = false;
+};
+
+class Mbc3 : public Mapper {
+public:
+    Mbc3(std::uint16_t rom_banks, std::uint32_t ram_size, bool has_rtc);
+    bool write(std::uint16_t addr, std::uint8_t value) override;
+    std::uint8_t read_ram(std::uint16_t addr) override;
+    /* The RTC is saved in the 48-byte layout most emulators use: the current
+     * and latched registers as 32-bit words, then a 64-bit UNIX time. */
+    std::vector<std::uint8_t> save_footer() override;
+    void load_save_footer(const std::uint8_t* footer, std::size_t size) override;
+    void save_state(SnapshotWriter& writer, bool include_ram) override;
+    bool load_state(SnapshotReader& reader, bool include_ram) override;
+private:
+    void update_banks();
+    /* Seconds counted by the clock, after wrapping the day counter. */
+    std::uint32_t rtc_counter();
+    void set_rtc_counter(std::uint32_t counter);
+    void latch_rtc();
+    void write_rtc(std::uint8_t reg, std::uint8_t value);
+
+    bool has_rtc;
+    bool ram_enabled = false;
+    std::uint8_t ram_bank = 0;
+    std::uint8_t prev_rtc_latch = 0xff;
+
+    /* The clock counts wall time from rtc_base, or sits at rtc_halted_counter
+     * while the halt flag is set. Registers 0x8-0xc read from rtc_latched. */
+    std::time_t rtc_base = 0;
+    std::uint32_t rtc_halted_counter = 0;
+    bool rtc_halted = false;
+    bool rtc_carry = false;
+    std::uint8_t rtc_latched[5]{0};
+};
+
+class Mbc5 : public Mapper {
+public:
+    Mbc5(std::uint16_t rom_banks, std::uint32_t ram_size, bool has_rumble);
+    bool write(std::uint16_t addr, std::uint8_t value) override;
+    bool rumble() const override {return this->motor_on;}
+    void save_state(SnapshotWriter& writer, bool include_ram) override;
+    bool load_state(SnapshotReader& reader, bool include_ram) override;
+private:
+    void update_banks();
+
+    bool has_rumble;
+    bool motor_on = false;
+    bool ram_enabled = false;
+    std::uint16_t rom_bank = 1;
+    std::uint8_t ram_bank = 0;
+};
+
+/* Picks the mapper for the cartridge type and RAM size in the ROM header. */
+Mapper* create_mapper(const std::uint8_t* rom, std::uint16_t rom_banks);
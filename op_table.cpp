@@ -1,521 +0,0 @@
-#include "op_table.h"
-#include "instruction.h"
-
-#include <vector>
-
-std::vector<Instruction> ops = {
-{"NOP", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 3, 2, "BC", "d16", 12, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "(BC)", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"INC", 1, 1, "BC", "NONE", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"INC", 1, 1, "B", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"DEC", 1, 1, "B", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"LD", 2, 2, "B", "d8", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RLCA", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"LD", 3, 2, "(a16)", "SP", 20, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"ADD", 1, 2, "HL", "BC", 8, 0, {FlagEffect::IGNORE, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"LD", 1, 2, "A", "(BC)", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"DEC", 1, 1, "BC", "NONE", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"INC", 1, 1, "C", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"DEC", 1, 1, "C", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"LD", 2, 2, "C", "d8", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RRCA", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"STOP", 2, 1, "0", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 3, 2, "DE", "d16", 12, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "(DE)", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"INC", 1, 1, "DE", "NONE", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"INC", 1, 1, "D", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"DEC", 1, 1, "D", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"LD", 2, 2, "D", "d8", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RLA", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"JR", 2, 1, "r8", "NONE", 12, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"ADD", 1, 2, "HL", "DE", 8, 0, {FlagEffect::IGNORE, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"LD", 1, 2, "A", "(DE)", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"DEC", 1, 1, "DE", "NONE", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"INC", 1, 1, "E", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"DEC", 1, 1, "E", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"LD", 2, 2, "E", "d8", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RRA", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"JR", 2, 2, "NZ", "r8", 12, 8, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 3, 2, "HL", "d16", 12, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "(HL+)", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"INC", 1, 1, "HL", "NONE", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"INC", 1, 1, "H", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"DEC", 1, 1, "H", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"LD", 2, 2, "H", "d8", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"DAA", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::IGNORE, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"JR", 2, 2, "Z", "r8", 12, 8, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"ADD", 1, 2, "HL", "HL", 8, 0, {FlagEffect::IGNORE, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"LD", 1, 2, "A", "(HL+)", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"DEC", 1, 1, "HL", "NONE", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"INC", 1, 1, "L", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"DEC", 1, 1, "L", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"LD", 2, 2, "L", "d8", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"CPL", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::SET, FlagEffect::SET, FlagEffect::IGNORE}},
-{"JR", 2, 2, "NC", "r8", 12, 8, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 3, 2, "SP", "d16", 12, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "(HL-)", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"INC", 1, 1, "SP", "NONE", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"INC", 1, 1, "(HL)", "NONE", 12, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"DEC", 1, 1, "(HL)", "NONE", 12, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"LD", 2, 2, "(HL)", "d8", 12, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SCF", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::SET}},
-{"JR", 2, 2, "C", "r8", 12, 8, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"ADD", 1, 2, "HL", "SP", 8, 0, {FlagEffect::IGNORE, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"LD", 1, 2, "A", "(HL-)", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"DEC", 1, 1, "SP", "NONE", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"INC", 1, 1, "A", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"DEC", 1, 1, "A", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::IGNORE}},
-{"LD", 2, 2, "A", "d8", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"CCF", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"LD", 1, 2, "B", "B", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "B", "C", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "B", "D", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "B", "E", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "B", "H", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "B", "L", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "B", "(HL)", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "B", "A", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "C", "B", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "C", "C", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "C", "D", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "C", "E", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "C", "H", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "C", "L", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "C", "(HL)", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "C", "A", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "D", "B", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "D", "C", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "D", "D", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "D", "E", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "D", "H", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "D", "L", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "D", "(HL)", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "D", "A", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "E", "B", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "E", "C", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "E", "D", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "E", "E", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "E", "H", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "E", "L", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "E", "(HL)", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "E", "A", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "H", "B", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "H", "C", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "H", "D", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "H", "E", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "H", "H", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "H", "L", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "H", "(HL)", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "H", "A", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "L", "B", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "L", "C", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "L", "D", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "L", "E", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "L", "H", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "L", "L", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "L", "(HL)", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "L", "A", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "(HL)", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "(HL)", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "(HL)", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "(HL)", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "(HL)", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "(HL)", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"HALT", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "(HL)", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "A", "B", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "A", "C", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "A", "D", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "A", "E", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "A", "H", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "A", "L", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "A", "(HL)", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "A", "A", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"ADD", 1, 2, "A", "B", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADD", 1, 2, "A", "C", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADD", 1, 2, "A", "D", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADD", 1, 2, "A", "E", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADD", 1, 2, "A", "H", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADD", 1, 2, "A", "L", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADD", 1, 2, "A", "(HL)", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADD", 1, 2, "A", "A", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADC", 1, 2, "A", "B", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADC", 1, 2, "A", "C", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADC", 1, 2, "A", "D", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADC", 1, 2, "A", "E", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADC", 1, 2, "A", "H", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADC", 1, 2, "A", "L", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADC", 1, 2, "A", "(HL)", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"ADC", 1, 2, "A", "A", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SUB", 1, 1, "B", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SUB", 1, 1, "C", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SUB", 1, 1, "D", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SUB", 1, 1, "E", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SUB", 1, 1, "H", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SUB", 1, 1, "L", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SUB", 1, 1, "(HL)", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SUB", 1, 1, "A", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SBC", 1, 2, "A", "B", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SBC", 1, 2, "A", "C", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SBC", 1, 2, "A", "D", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SBC", 1, 2, "A", "E", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SBC", 1, 2, "A", "H", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SBC", 1, 2, "A", "L", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SBC", 1, 2, "A", "(HL)", 8, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"SBC", 1, 2, "A", "A", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"AND", 1, 1, "B", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::CLEAR}},
-{"AND", 1, 1, "C", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::CLEAR}},
-{"AND", 1, 1, "D", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::CLEAR}},
-{"AND", 1, 1, "E", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::CLEAR}},
-{"AND", 1, 1, "H", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::CLEAR}},
-{"AND", 1, 1, "L", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::CLEAR}},
-{"AND", 1, 1, "(HL)", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::CLEAR}},
-{"AND", 1, 1, "A", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::CLEAR}},
-{"XOR", 1, 1, "B", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"XOR", 1, 1, "C", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"XOR", 1, 1, "D", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"XOR", 1, 1, "E", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"XOR", 1, 1, "H", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"XOR", 1, 1, "L", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"XOR", 1, 1, "(HL)", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"XOR", 1, 1, "A", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"OR", 1, 1, "B", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"OR", 1, 1, "C", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"OR", 1, 1, "D", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"OR", 1, 1, "E", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"OR", 1, 1, "H", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"OR", 1, 1, "L", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"OR", 1, 1, "(HL)", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"OR", 1, 1, "A", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"CP", 1, 1, "B", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"CP", 1, 1, "C", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"CP", 1, 1, "D", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"CP", 1, 1, "E", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"CP", 1, 1, "H", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"CP", 1, 1, "L", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"CP", 1, 1, "(HL)", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"CP", 1, 1, "A", "NONE", 4, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"RET", 1, 1, "NZ", "NONE", 20, 8, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"POP", 1, 1, "BC", "NONE", 12, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"JP", 3, 2, "NZ", "a16", 16, 12, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"JP", 3, 1, "a16", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"CALL", 3, 2, "NZ", "a16", 24, 12, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"PUSH", 1, 1, "BC", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"ADD", 2, 2, "A", "d8", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"RST", 1, 1, "00H", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RET", 1, 1, "Z", "NONE", 20, 8, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RET", 1, 0, "NONE", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"JP", 3, 2, "Z", "a16", 16, 12, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"PREFIX", 1, 1, "CB", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"CALL", 3, 2, "Z", "a16", 24, 12, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"CALL", 3, 1, "a16", "NONE", 24, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"ADC", 2, 2, "A", "d8", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"RST", 1, 1, "08H", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RET", 1, 1, "NC", "NONE", 20, 8, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"POP", 1, 1, "DE", "NONE", 12, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"JP", 3, 2, "NC", "a16", 16, 12, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"NOP", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"CALL", 3, 2, "NC", "a16", 24, 12, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"PUSH", 1, 1, "DE", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SUB", 2, 1, "d8", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"RST", 1, 1, "10H", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RET", 1, 1, "C", "NONE", 20, 8, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RETI", 1, 0, "NONE", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"JP", 3, 2, "C", "a16", 16, 12, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"NOP", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"CALL", 3, 2, "C", "a16", 24, 12, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"NOP", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SBC", 2, 2, "A", "d8", 8, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"RST", 1, 1, "18H", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LDH", 2, 2, "(a8)", "A", 12, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"POP", 1, 1, "HL", "NONE", 12, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 1, 2, "(C)", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"NOP", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"NOP", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"PUSH", 1, 1, "HL", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"AND", 2, 1, "d8", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::CLEAR}},
-{"RST", 1, 1, "20H", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"ADD", 2, 2, "SP", "r8", 16, 0, {FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"JP", 1, 1, "(HL)", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 3, 2, "(a16)", "A", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"NOP", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"NOP", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"NOP", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"XOR", 2, 1, "d8", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"RST", 1, 1, "28H", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LDH", 2, 2, "A", "(a8)", 12, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"POP", 1, 1, "AF", "NONE", 12, 0, {FlagEffect::APPLY, FlagEffect::APPLY, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"LD", 1, 2, "A", "(C)", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"DI", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"NOP", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"PUSH", 1, 1, "AF", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"OR", 2, 1, "d8", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"RST", 1, 1, "30H", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 2, 2, "HL", "SP+r8", 12, 0, {FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"LD", 1, 2, "SP", "HL", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"LD", 3, 2, "A", "(a16)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"EI", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"NOP", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"NOP", 1, 0, "NONE", "NONE", 4, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"CP", 2, 1, "d8", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::SET, FlagEffect::APPLY, FlagEffect::APPLY}},
-{"RST", 1, 1, "38H", "NONE", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-};
-std::vector<Instruction> ops_cb = {
-{"RLC", 2, 1, "B", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RLC", 2, 1, "C", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RLC", 2, 1, "D", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RLC", 2, 1, "E", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RLC", 2, 1, "H", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RLC", 2, 1, "L", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RLC", 2, 1, "(HL)", "NONE", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RLC", 2, 1, "A", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RRC", 2, 1, "B", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RRC", 2, 1, "C", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RRC", 2, 1, "D", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RRC", 2, 1, "E", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RRC", 2, 1, "H", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RRC", 2, 1, "L", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RRC", 2, 1, "(HL)", "NONE", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RRC", 2, 1, "A", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RL", 2, 1, "B", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RL", 2, 1, "C", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RL", 2, 1, "D", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RL", 2, 1, "E", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RL", 2, 1, "H", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RL", 2, 1, "L", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RL", 2, 1, "(HL)", "NONE", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RL", 2, 1, "A", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RR", 2, 1, "B", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RR", 2, 1, "C", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RR", 2, 1, "D", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RR", 2, 1, "E", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RR", 2, 1, "H", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RR", 2, 1, "L", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RR", 2, 1, "(HL)", "NONE", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"RR", 2, 1, "A", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SLA", 2, 1, "B", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SLA", 2, 1, "C", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SLA", 2, 1, "D", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SLA", 2, 1, "E", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SLA", 2, 1, "H", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SLA", 2, 1, "L", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SLA", 2, 1, "(HL)", "NONE", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SLA", 2, 1, "A", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SRA", 2, 1, "B", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SRA", 2, 1, "C", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SRA", 2, 1, "D", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SRA", 2, 1, "E", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SRA", 2, 1, "H", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SRA", 2, 1, "L", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SRA", 2, 1, "(HL)", "NONE", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SRA", 2, 1, "A", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SWAP", 2, 1, "B", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SWAP", 2, 1, "C", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SWAP", 2, 1, "D", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SWAP", 2, 1, "E", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SWAP", 2, 1, "H", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SWAP", 2, 1, "L", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SWAP", 2, 1, "(HL)", "NONE", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SWAP", 2, 1, "A", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::CLEAR}},
-{"SRL", 2, 1, "B", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SRL", 2, 1, "C", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SRL", 2, 1, "D", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SRL", 2, 1, "E", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SRL", 2, 1, "H", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SRL", 2, 1, "L", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SRL", 2, 1, "(HL)", "NONE", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"SRL", 2, 1, "A", "NONE", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::CLEAR, FlagEffect::APPLY}},
-{"BIT", 2, 2, "0", "B", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "0", "C", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "0", "D", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "0", "E", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "0", "H", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "0", "L", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "0", "(HL)", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "0", "A", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "1", "B", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "1", "C", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "1", "D", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "1", "E", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "1", "H", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "1", "L", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "1", "(HL)", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "1", "A", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "2", "B", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "2", "C", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "2", "D", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "2", "E", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "2", "H", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "2", "L", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "2", "(HL)", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "2", "A", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "3", "B", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "3", "C", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "3", "D", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "3", "E", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "3", "H", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "3", "L", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "3", "(HL)", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "3", "A", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "4", "B", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "4", "C", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "4", "D", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "4", "E", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "4", "H", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "4", "L", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "4", "(HL)", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "4", "A", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "5", "B", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "5", "C", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "5", "D", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "5", "E", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "5", "H", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "5", "L", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "5", "(HL)", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "5", "A", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "6", "B", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "6", "C", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "6", "D", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "6", "E", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "6", "H", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "6", "L", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "6", "(HL)", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "6", "A", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "7", "B", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "7", "C", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "7", "D", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "7", "E", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "7", "H", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "7", "L", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "7", "(HL)", 16, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"BIT", 2, 2, "7", "A", 8, 0, {FlagEffect::APPLY, FlagEffect::CLEAR, FlagEffect::SET, FlagEffect::IGNORE}},
-{"RES", 2, 2, "0", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "0", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "0", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "0", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "0", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "0", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "0", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "0", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "1", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "1", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "1", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "1", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "1", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "1", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "1", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "1", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "2", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "2", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "2", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "2", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "2", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "2", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "2", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "2", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "3", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "3", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "3", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "3", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "3", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "3", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "3", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "3", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "4", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "4", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "4", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "4", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "4", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "4", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "4", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "4", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "5", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "5", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "5", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "5", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "5", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "5", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "5", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "5", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "6", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "6", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "6", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "6", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "6", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "6", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "6", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "6", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "7", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "7", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "7", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "7", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "7", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "7", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "7", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"RES", 2, 2, "7", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "0", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "0", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "0", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "0", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "0", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "0", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "0", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "0", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "1", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "1", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "1", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "1", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "1", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "1", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "1", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "1", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "2", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "2", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "2", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "2", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "2", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "2", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "2", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "2", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "3", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "3", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "3", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "3", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "3", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "3", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "3", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "3", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "4", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "4", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "4", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "4", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "4", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "4", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "4", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "4", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "5", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "5", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "5", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "5", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "5", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "5", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "5", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "5", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "6", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "6", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "6", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "6", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "6", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "6", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "6", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "6", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "7", "B", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "7", "C", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "7", "D", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "7", "E", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "7", "H", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "7", "L", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "7", "(HL)", 16, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-{"SET", 2, 2, "7", "A", 8, 0, {FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE, FlagEffect::IGNORE}},
-};
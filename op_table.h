@@ -1,8 +1,530 @@
 #pragma once
 
 #include "instruction.h"
+#include "ops.h"
 
-#include <vector>
+#include <array>
+#include <cstdint>
 
-extern std::vector<Instruction> ops;
-extern std::vector<Instruction> ops_cb;
+inline constexpr std::array<Instruction, 256> ops = {{
+{"NOP", &NOP, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 3, 2, {OperandKind::REGISTER_PAIR, PAIR_BC, "BC"}, {OperandKind::D16, 0, "d16"}, 12, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::MEM_REGISTER_PAIR, PAIR_BC, "(BC)"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"INC", &INC, 1, 1, {OperandKind::REGISTER_PAIR, PAIR_BC, "BC"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, 0, 0, 0},
+{"INC", &INC, 1, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H, 0, FLAG_N},
+{"DEC", &DEC, 1, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H, FLAG_N, 0},
+{"LD", &LD, 2, 2, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::D8, 0, "d8"}, 8, 0, 0, 0, 0},
+{"RLCA", &RLCA, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_C, 0, FLAG_Z | FLAG_N | FLAG_H},
+{"LD", &LD, 3, 2, {OperandKind::MEM_A16, 0, "(a16)"}, {OperandKind::SP, 0, "SP"}, 20, 0, 0, 0, 0},
+{"ADD", &ADD, 1, 2, {OperandKind::REGISTER_PAIR, PAIR_HL, "HL"}, {OperandKind::REGISTER_PAIR, PAIR_BC, "BC"}, 8, 0, FLAG_H | FLAG_C, 0, FLAG_N},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_BC, "(BC)"}, 8, 0, 0, 0, 0},
+{"DEC", &DEC, 1, 1, {OperandKind::REGISTER_PAIR, PAIR_BC, "BC"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, 0, 0, 0},
+{"INC", &INC, 1, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H, 0, FLAG_N},
+{"DEC", &DEC, 1, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H, FLAG_N, 0},
+{"LD", &LD, 2, 2, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::D8, 0, "d8"}, 8, 0, 0, 0, 0},
+{"RRCA", &RRCA, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_C, 0, FLAG_Z | FLAG_N | FLAG_H},
+{"STOP", &STOP, 2, 1, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 3, 2, {OperandKind::REGISTER_PAIR, PAIR_DE, "DE"}, {OperandKind::D16, 0, "d16"}, 12, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::MEM_REGISTER_PAIR, PAIR_DE, "(DE)"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"INC", &INC, 1, 1, {OperandKind::REGISTER_PAIR, PAIR_DE, "DE"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, 0, 0, 0},
+{"INC", &INC, 1, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H, 0, FLAG_N},
+{"DEC", &DEC, 1, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H, FLAG_N, 0},
+{"LD", &LD, 2, 2, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::D8, 0, "d8"}, 8, 0, 0, 0, 0},
+{"RLA", &RLA, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_C, 0, FLAG_Z | FLAG_N | FLAG_H},
+{"JR", &JR, 2, 1, {OperandKind::R8, 0, "r8"}, {OperandKind::NONE, 0, "NONE"}, 12, 0, 0, 0, 0},
+{"ADD", &ADD, 1, 2, {OperandKind::REGISTER_PAIR, PAIR_HL, "HL"}, {OperandKind::REGISTER_PAIR, PAIR_DE, "DE"}, 8, 0, FLAG_H | FLAG_C, 0, FLAG_N},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_DE, "(DE)"}, 8, 0, 0, 0, 0},
+{"DEC", &DEC, 1, 1, {OperandKind::REGISTER_PAIR, PAIR_DE, "DE"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, 0, 0, 0},
+{"INC", &INC, 1, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H, 0, FLAG_N},
+{"DEC", &DEC, 1, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H, FLAG_N, 0},
+{"LD", &LD, 2, 2, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::D8, 0, "d8"}, 8, 0, 0, 0, 0},
+{"RRA", &RRA, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_C, 0, FLAG_Z | FLAG_N | FLAG_H},
+{"JR", &JR, 2, 2, {OperandKind::CONDITION, COND_NZ, "NZ"}, {OperandKind::R8, 0, "r8"}, 12, 8, 0, 0, 0},
+{"LD", &LD, 3, 2, {OperandKind::REGISTER_PAIR, PAIR_HL, "HL"}, {OperandKind::D16, 0, "d16"}, 12, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::MEM_HL_INC, 0, "(HL+)"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"INC", &INC, 1, 1, {OperandKind::REGISTER_PAIR, PAIR_HL, "HL"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, 0, 0, 0},
+{"INC", &INC, 1, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H, 0, FLAG_N},
+{"DEC", &DEC, 1, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H, FLAG_N, 0},
+{"LD", &LD, 2, 2, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::D8, 0, "d8"}, 8, 0, 0, 0, 0},
+{"DAA", &DAA, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_C, 0, FLAG_H},
+{"JR", &JR, 2, 2, {OperandKind::CONDITION, COND_Z, "Z"}, {OperandKind::R8, 0, "r8"}, 12, 8, 0, 0, 0},
+{"ADD", &ADD, 1, 2, {OperandKind::REGISTER_PAIR, PAIR_HL, "HL"}, {OperandKind::REGISTER_PAIR, PAIR_HL, "HL"}, 8, 0, FLAG_H | FLAG_C, 0, FLAG_N},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::MEM_HL_INC, 0, "(HL+)"}, 8, 0, 0, 0, 0},
+{"DEC", &DEC, 1, 1, {OperandKind::REGISTER_PAIR, PAIR_HL, "HL"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, 0, 0, 0},
+{"INC", &INC, 1, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H, 0, FLAG_N},
+{"DEC", &DEC, 1, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H, FLAG_N, 0},
+{"LD", &LD, 2, 2, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::D8, 0, "d8"}, 8, 0, 0, 0, 0},
+{"CPL", &CPL, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, FLAG_N | FLAG_H, 0},
+{"JR", &JR, 2, 2, {OperandKind::CONDITION, COND_NC, "NC"}, {OperandKind::R8, 0, "r8"}, 12, 8, 0, 0, 0},
+{"LD", &LD, 3, 2, {OperandKind::SP, 0, "SP"}, {OperandKind::D16, 0, "d16"}, 12, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::MEM_HL_DEC, 0, "(HL-)"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"INC", &INC, 1, 1, {OperandKind::SP, 0, "SP"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, 0, 0, 0},
+{"INC", &INC, 1, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 12, 0, FLAG_Z | FLAG_H, 0, FLAG_N},
+{"DEC", &DEC, 1, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 12, 0, FLAG_Z | FLAG_H, FLAG_N, 0},
+{"LD", &LD, 2, 2, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::D8, 0, "d8"}, 12, 0, 0, 0, 0},
+{"SCF", &NOP, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, FLAG_C, FLAG_N | FLAG_H},
+{"JR", &JR, 2, 2, {OperandKind::CONDITION, COND_C, "C"}, {OperandKind::R8, 0, "r8"}, 12, 8, 0, 0, 0},
+{"ADD", &ADD, 1, 2, {OperandKind::REGISTER_PAIR, PAIR_HL, "HL"}, {OperandKind::SP, 0, "SP"}, 8, 0, FLAG_H | FLAG_C, 0, FLAG_N},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::MEM_HL_DEC, 0, "(HL-)"}, 8, 0, 0, 0, 0},
+{"DEC", &DEC, 1, 1, {OperandKind::SP, 0, "SP"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, 0, 0, 0},
+{"INC", &INC, 1, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H, 0, FLAG_N},
+{"DEC", &DEC, 1, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H, FLAG_N, 0},
+{"LD", &LD, 2, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::D8, 0, "d8"}, 8, 0, 0, 0, 0},
+{"CCF", &CCF, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_C, 0, FLAG_N | FLAG_H},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::REGISTER, REG_B, "B"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::REGISTER, REG_C, "C"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::REGISTER, REG_D, "D"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::REGISTER, REG_E, "E"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::REGISTER, REG_H, "H"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::REGISTER, REG_L, "L"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 8, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::REGISTER, REG_A, "A"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::REGISTER, REG_B, "B"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::REGISTER, REG_C, "C"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::REGISTER, REG_D, "D"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::REGISTER, REG_E, "E"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::REGISTER, REG_H, "H"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::REGISTER, REG_L, "L"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 8, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::REGISTER, REG_A, "A"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::REGISTER, REG_B, "B"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::REGISTER, REG_C, "C"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::REGISTER, REG_D, "D"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::REGISTER, REG_E, "E"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::REGISTER, REG_H, "H"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::REGISTER, REG_L, "L"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 8, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::REGISTER, REG_A, "A"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::REGISTER, REG_B, "B"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::REGISTER, REG_C, "C"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::REGISTER, REG_D, "D"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::REGISTER, REG_E, "E"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::REGISTER, REG_H, "H"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::REGISTER, REG_L, "L"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 8, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::REGISTER, REG_A, "A"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::REGISTER, REG_B, "B"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::REGISTER, REG_C, "C"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::REGISTER, REG_D, "D"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::REGISTER, REG_E, "E"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::REGISTER, REG_H, "H"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::REGISTER, REG_L, "L"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 8, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::REGISTER, REG_A, "A"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::REGISTER, REG_B, "B"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::REGISTER, REG_C, "C"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::REGISTER, REG_D, "D"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::REGISTER, REG_E, "E"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::REGISTER, REG_H, "H"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::REGISTER, REG_L, "L"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 8, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::REGISTER, REG_A, "A"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"HALT", &HALT, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_B, "B"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_C, "C"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_D, "D"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_E, "E"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_H, "H"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_L, "L"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 8, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_A, "A"}, 4, 0, 0, 0, 0},
+{"ADD", &ADD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_B, "B"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADD", &ADD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_C, "C"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADD", &ADD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_D, "D"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADD", &ADD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_E, "E"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADD", &ADD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_H, "H"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADD", &ADD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_L, "L"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADD", &ADD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 8, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADD", &ADD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_A, "A"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADC", &ADC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_B, "B"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADC", &ADC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_C, "C"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADC", &ADC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_D, "D"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADC", &ADC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_E, "E"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADC", &ADC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_H, "H"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADC", &ADC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_L, "L"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADC", &ADC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 8, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"ADC", &ADC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_A, "A"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"SUB", &SUB, 1, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SUB", &SUB, 1, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SUB", &SUB, 1, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SUB", &SUB, 1, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SUB", &SUB, 1, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SUB", &SUB, 1, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SUB", &SUB, 1, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SUB", &SUB, 1, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SBC", &SBC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_B, "B"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SBC", &SBC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_C, "C"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SBC", &SBC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_D, "D"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SBC", &SBC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_E, "E"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SBC", &SBC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_H, "H"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SBC", &SBC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_L, "L"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SBC", &SBC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 8, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"SBC", &SBC, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::REGISTER, REG_A, "A"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"AND", &AND, 1, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, FLAG_H, FLAG_N | FLAG_C},
+{"AND", &AND, 1, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, FLAG_H, FLAG_N | FLAG_C},
+{"AND", &AND, 1, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, FLAG_H, FLAG_N | FLAG_C},
+{"AND", &AND, 1, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, FLAG_H, FLAG_N | FLAG_C},
+{"AND", &AND, 1, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, FLAG_H, FLAG_N | FLAG_C},
+{"AND", &AND, 1, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, FLAG_H, FLAG_N | FLAG_C},
+{"AND", &AND, 1, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N | FLAG_C},
+{"AND", &AND, 1, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, FLAG_H, FLAG_N | FLAG_C},
+{"XOR", &XOR, 1, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"XOR", &XOR, 1, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"XOR", &XOR, 1, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"XOR", &XOR, 1, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"XOR", &XOR, 1, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"XOR", &XOR, 1, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"XOR", &XOR, 1, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"XOR", &XOR, 1, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"OR", &OR, 1, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"OR", &OR, 1, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"OR", &OR, 1, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"OR", &OR, 1, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"OR", &OR, 1, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"OR", &OR, 1, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"OR", &OR, 1, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"OR", &OR, 1, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"CP", &CP, 1, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"CP", &CP, 1, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"CP", &CP, 1, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"CP", &CP, 1, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"CP", &CP, 1, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"CP", &CP, 1, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"CP", &CP, 1, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"CP", &CP, 1, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"RET", &RET, 1, 1, {OperandKind::CONDITION, COND_NZ, "NZ"}, {OperandKind::NONE, 0, "NONE"}, 20, 8, 0, 0, 0},
+{"POP", &POP, 1, 1, {OperandKind::REGISTER_PAIR, PAIR_BC, "BC"}, {OperandKind::NONE, 0, "NONE"}, 12, 0, 0, 0, 0},
+{"JP", &JP, 3, 2, {OperandKind::CONDITION, COND_NZ, "NZ"}, {OperandKind::A16, 0, "a16"}, 16, 12, 0, 0, 0},
+{"JP", &JP, 3, 1, {OperandKind::A16, 0, "a16"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+{"CALL", &CALL, 3, 2, {OperandKind::CONDITION, COND_NZ, "NZ"}, {OperandKind::A16, 0, "a16"}, 24, 12, 0, 0, 0},
+{"PUSH", &PUSH, 1, 1, {OperandKind::REGISTER_PAIR, PAIR_BC, "BC"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+{"ADD", &ADD, 2, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::D8, 0, "d8"}, 8, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"RST", &RST, 1, 1, {OperandKind::LITERAL, 0x0, "00H"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+{"RET", &RET, 1, 1, {OperandKind::CONDITION, COND_Z, "Z"}, {OperandKind::NONE, 0, "NONE"}, 20, 8, 0, 0, 0},
+{"RET", &RET, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+{"JP", &JP, 3, 2, {OperandKind::CONDITION, COND_Z, "Z"}, {OperandKind::A16, 0, "a16"}, 16, 12, 0, 0, 0},
+{"PREFIX", &NOP, 1, 1, {OperandKind::LITERAL, 0xcb, "CB"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"CALL", &CALL, 3, 2, {OperandKind::CONDITION, COND_Z, "Z"}, {OperandKind::A16, 0, "a16"}, 24, 12, 0, 0, 0},
+{"CALL", &CALL, 3, 1, {OperandKind::A16, 0, "a16"}, {OperandKind::NONE, 0, "NONE"}, 24, 0, 0, 0, 0},
+{"ADC", &ADC, 2, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::D8, 0, "d8"}, 8, 0, FLAG_Z | FLAG_H | FLAG_C, 0, FLAG_N},
+{"RST", &RST, 1, 1, {OperandKind::LITERAL, 0x8, "08H"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+{"RET", &RET, 1, 1, {OperandKind::CONDITION, COND_NC, "NC"}, {OperandKind::NONE, 0, "NONE"}, 20, 8, 0, 0, 0},
+{"POP", &POP, 1, 1, {OperandKind::REGISTER_PAIR, PAIR_DE, "DE"}, {OperandKind::NONE, 0, "NONE"}, 12, 0, 0, 0, 0},
+{"JP", &JP, 3, 2, {OperandKind::CONDITION, COND_NC, "NC"}, {OperandKind::A16, 0, "a16"}, 16, 12, 0, 0, 0},
+{"NOP", &NOP, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"CALL", &CALL, 3, 2, {OperandKind::CONDITION, COND_NC, "NC"}, {OperandKind::A16, 0, "a16"}, 24, 12, 0, 0, 0},
+{"PUSH", &PUSH, 1, 1, {OperandKind::REGISTER_PAIR, PAIR_DE, "DE"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+{"SUB", &SUB, 2, 1, {OperandKind::D8, 0, "d8"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"RST", &RST, 1, 1, {OperandKind::LITERAL, 0x10, "10H"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+{"RET", &RET, 1, 1, {OperandKind::CONDITION, COND_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 20, 8, 0, 0, 0},
+{"RETI", &RETI, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+{"JP", &JP, 3, 2, {OperandKind::CONDITION, COND_C, "C"}, {OperandKind::A16, 0, "a16"}, 16, 12, 0, 0, 0},
+{"NOP", &NOP, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"CALL", &CALL, 3, 2, {OperandKind::CONDITION, COND_C, "C"}, {OperandKind::A16, 0, "a16"}, 24, 12, 0, 0, 0},
+{"NOP", &NOP, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"SBC", &SBC, 2, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::D8, 0, "d8"}, 8, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"RST", &RST, 1, 1, {OperandKind::LITERAL, 0x18, "18H"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+{"LDH", &LD, 2, 2, {OperandKind::MEM_A8, 0, "(a8)"}, {OperandKind::REGISTER, REG_A, "A"}, 12, 0, 0, 0, 0},
+{"POP", &POP, 1, 1, {OperandKind::REGISTER_PAIR, PAIR_HL, "HL"}, {OperandKind::NONE, 0, "NONE"}, 12, 0, 0, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::MEM_C, 0, "(C)"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"NOP", &NOP, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"NOP", &NOP, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"PUSH", &PUSH, 1, 1, {OperandKind::REGISTER_PAIR, PAIR_HL, "HL"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+{"AND", &AND, 2, 1, {OperandKind::D8, 0, "d8"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N | FLAG_C},
+{"RST", &RST, 1, 1, {OperandKind::LITERAL, 0x20, "20H"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+{"ADD", &ADD, 2, 2, {OperandKind::SP, 0, "SP"}, {OperandKind::R8, 0, "r8"}, 16, 0, FLAG_H | FLAG_C, 0, FLAG_Z | FLAG_N},
+{"JP", &JP, 1, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"LD", &LD, 3, 2, {OperandKind::MEM_A16, 0, "(a16)"}, {OperandKind::REGISTER, REG_A, "A"}, 16, 0, 0, 0, 0},
+{"NOP", &NOP, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"NOP", &NOP, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"NOP", &NOP, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"XOR", &XOR, 2, 1, {OperandKind::D8, 0, "d8"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"RST", &RST, 1, 1, {OperandKind::LITERAL, 0x28, "28H"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+{"LDH", &LD, 2, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::MEM_A8, 0, "(a8)"}, 12, 0, 0, 0, 0},
+{"POP", &POP, 1, 1, {OperandKind::REGISTER_PAIR, PAIR_AF, "AF"}, {OperandKind::NONE, 0, "NONE"}, 12, 0, FLAG_Z | FLAG_N | FLAG_H | FLAG_C, 0, 0},
+{"LD", &LD, 1, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::MEM_C, 0, "(C)"}, 8, 0, 0, 0, 0},
+{"DI", &DI, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"NOP", &NOP, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"PUSH", &PUSH, 1, 1, {OperandKind::REGISTER_PAIR, PAIR_AF, "AF"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+{"OR", &OR, 2, 1, {OperandKind::D8, 0, "d8"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"RST", &RST, 1, 1, {OperandKind::LITERAL, 0x30, "30H"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+{"LD", &LD, 2, 2, {OperandKind::REGISTER_PAIR, PAIR_HL, "HL"}, {OperandKind::SP_R8, 0, "SP+r8"}, 12, 0, FLAG_H | FLAG_C, 0, FLAG_Z | FLAG_N},
+{"LD", &LD, 1, 2, {OperandKind::SP, 0, "SP"}, {OperandKind::REGISTER_PAIR, PAIR_HL, "HL"}, 8, 0, 0, 0, 0},
+{"LD", &LD, 3, 2, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::MEM_A16, 0, "(a16)"}, 16, 0, 0, 0, 0},
+{"EI", &EI, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"NOP", &NOP, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"NOP", &NOP, 1, 0, {OperandKind::NONE, 0, "NONE"}, {OperandKind::NONE, 0, "NONE"}, 4, 0, 0, 0, 0},
+{"CP", &CP, 2, 1, {OperandKind::D8, 0, "d8"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_H | FLAG_C, FLAG_N, 0},
+{"RST", &RST, 1, 1, {OperandKind::LITERAL, 0x38, "38H"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, 0, 0, 0},
+}};
+inline constexpr std::array<Instruction, 256> ops_cb = {{
+{"RLC", &RLC, 2, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RLC", &RLC, 2, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RLC", &RLC, 2, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RLC", &RLC, 2, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RLC", &RLC, 2, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RLC", &RLC, 2, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RLC", &RLC, 2, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RLC", &RLC, 2, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RRC", &RRC, 2, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RRC", &RRC, 2, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RRC", &RRC, 2, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RRC", &RRC, 2, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RRC", &RRC, 2, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RRC", &RRC, 2, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RRC", &RRC, 2, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RRC", &RRC, 2, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RL", &RL, 2, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RL", &RL, 2, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RL", &RL, 2, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RL", &RL, 2, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RL", &RL, 2, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RL", &RL, 2, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RL", &RL, 2, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RL", &RL, 2, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RR", &RR, 2, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RR", &RR, 2, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RR", &RR, 2, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RR", &RR, 2, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RR", &RR, 2, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RR", &RR, 2, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RR", &RR, 2, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"RR", &RR, 2, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SLA", &SLA, 2, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SLA", &SLA, 2, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SLA", &SLA, 2, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SLA", &SLA, 2, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SLA", &SLA, 2, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SLA", &SLA, 2, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SLA", &SLA, 2, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SLA", &SLA, 2, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SRA", &SRA, 2, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SRA", &SRA, 2, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SRA", &SRA, 2, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SRA", &SRA, 2, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SRA", &SRA, 2, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SRA", &SRA, 2, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SRA", &SRA, 2, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SRA", &SRA, 2, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SWAP", &SWAP, 2, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SWAP", &SWAP, 2, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SWAP", &SWAP, 2, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SWAP", &SWAP, 2, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SWAP", &SWAP, 2, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SWAP", &SWAP, 2, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SWAP", &SWAP, 2, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SWAP", &SWAP, 2, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z, 0, FLAG_N | FLAG_H | FLAG_C},
+{"SRL", &SRL, 2, 1, {OperandKind::REGISTER, REG_B, "B"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SRL", &SRL, 2, 1, {OperandKind::REGISTER, REG_C, "C"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SRL", &SRL, 2, 1, {OperandKind::REGISTER, REG_D, "D"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SRL", &SRL, 2, 1, {OperandKind::REGISTER, REG_E, "E"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SRL", &SRL, 2, 1, {OperandKind::REGISTER, REG_H, "H"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SRL", &SRL, 2, 1, {OperandKind::REGISTER, REG_L, "L"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SRL", &SRL, 2, 1, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, {OperandKind::NONE, 0, "NONE"}, 16, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"SRL", &SRL, 2, 1, {OperandKind::REGISTER, REG_A, "A"}, {OperandKind::NONE, 0, "NONE"}, 8, 0, FLAG_Z | FLAG_C, 0, FLAG_N | FLAG_H},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"BIT", &BIT, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, FLAG_Z, FLAG_H, FLAG_N},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"RES", &RES, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x0, "0"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x1, "1"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x2, "2"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x3, "3"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x4, "4"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x5, "5"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x6, "6"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_B, "B"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_C, "C"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_D, "D"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_E, "E"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_H, "H"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_L, "L"}, 8, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::MEM_REGISTER_PAIR, PAIR_HL, "(HL)"}, 16, 0, 0, 0, 0},
+{"SET", &SET, 2, 2, {OperandKind::LITERAL, 0x7, "7"}, {OperandKind::REGISTER, REG_A, "A"}, 8, 0, 0, 0, 0},
+}};
+
+/* Opcodes 0x100-0x1ff are the CB-prefixed instructions. */
+constexpr const Instruction& decode_instruction(std::uint16_t opcode)
+{
+    return opcode >= 0x100 ? ops_cb[opcode & 0xff] : ops[opcode];
+}
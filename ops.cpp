@@ -3,14 +3,12 @@
 #include "op_table.h"
 #include "state.h"
 
-#include <cinttypes>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
-#include <map>
 #include <unordered_set>
-#include <string>
 #include <utility>
-#include <vector>
 
 using std::uint8_t;
 using std::uint16_t;
@@ -20,50 +18,41 @@ using std::int8_t;
 using std::int16_t;
 using std::int32_t;
 using std::int64_t;
+using std::size_t;
+using std::array;
 using std::cout;
 using std::hex;
+using std::index_sequence;
+using std::make_index_sequence;
 using std::make_pair;
 using std::pair;
-using std::unordered_map;
 using std::unordered_set;
-using std::string;
-using std::vector;
-
-unordered_map<string, OpFunction> op_functions {
-    {"NOP", &NOP}, {"STOP", &STOP}, {"JR", &JR}, {"LD", &LD}, {"INC", &INC}, {"DEC", &DEC},
-    {"RLCA", &RLCA}, {"RLA", &RLA}, {"DAA", &DAA}, {"SCF", &NOP}, {"ADD", &ADD}, 
-    {"RRCA", &RRCA}, {"RRA", &RRA}, {"CPL", &CPL}, {"CCF", &CCF}, {"ADC", &ADC},
-    {"HALT", &HALT}, {"SUB", &SUB}, {"SBC", &SBC}, {"AND", &AND}, {"XOR", &XOR}, {"OR", OR},
-    {"CP", &CP}, {"RET", &RET}, {"LDH", &LD}, {"POP", &POP}, {"JP", &JP}, {"DI", &DI},
-    {"CALL", &CALL}, {"PUSH", &PUSH}, {"RST", &RST}, {"RETI", &RETI}, {"EI", &EI},
-    {"RLC", &RLC}, {"RRC", &RRC}, {"RL", &RL}, {"RR", &RR}, {"SLA", &SLA}, {"SRA", &SRA},
-    {"SWAP", &SWAP}, {"SRL", &SRL}, {"BIT", &BIT}, {"RES", &RES}, {"SET", &SET} 
-};
 
 unordered_set<uint8_t> invalid_ops = {0xd3, 0xdd, 0xdb, 0xe3, 0xe4, 0xeb,
 	                              0xec, 0xed, 0xf4, 0xfc, 0xfd};
-unordered_set<uint8_t> ops_16b {0x09, 0x19, 0x29, 0x39};
 
-uint32_t execute_op(State& state)
+/* Each opcode gets its own copy of the handler and the flag update. The
+ * descriptor is a compile time constant here, so flattening the call lets
+ * the compiler resolve operand kinds and flag masks for every opcode. */
+template <uint16_t OPCODE>
+__attribute__((flatten)) void execute_specialized_op(State& state, const OpCode& op_code)
 {
-    uint8_t op = state.read_memory(state.pc);
-    vector<uint8_t> op_code(0);
-    Instruction instruction = ops[0];
+    constexpr const Instruction& instruction = decode_instruction(OPCODE);
+    constexpr OpFunction function = instruction.function;
+    auto operands = function(state, instruction, op_code);
+    defer_flags(state, OPCODE, operands);
+}
 
-    if (op == 0xcb) {
-	op_code.resize(2);
-	op_code[0] = op;
-	op_code[1] = state.read_memory(state.pc + 1);
-        instruction = ops_cb[op_code[1]];
-    } else {
-        instruction = ops[op];
-	op_code.resize(instruction.bytes);
-	op_code[0] = op;
-	for (uint8_t i = 1; i < instruction.bytes; i++) {
-	    op_code[i] = state.read_memory(state.pc + i);
-	}
-    }
+template <size_t... OPCODES>
+constexpr array<SpecializedOpFunction, sizeof...(OPCODES)> make_specialized_ops(index_sequence<OPCODES...>)
+{
+    return {{&execute_specialized_op<OPCODES>...}};
+}
+
+constexpr array<SpecializedOpFunction, 0x200> specialized_ops = make_specialized_ops(make_index_sequence<0x200>());
 
+static inline void check_op(State& state, const OpCode& op_code)
+{
     if (invalid_ops.find(op_code[0]) != invalid_ops.end()) {
 	cout << "[WARNING]: Invalid instruction encountered at " << hex << state.pc << ".\n";
     }
@@ -71,14 +60,10 @@ uint32_t execute_op(State& state)
     if (!address_executable(state.pc)) {
 	cout << "[WARNING]: PC at unexecutable address: " << hex << state.pc << ".\n";
     }
+}
 
-    state.pc += instruction.bytes;
-    uint16_t prev_pc = state.pc;
-
-    bool is_16_bit = ops_16b.find(op_code[0]) != ops_16b.end();
-
-    auto operands = op_functions[instruction.name](state, instruction, op_code);
-    update_flags(state, op_code, operands, is_16_bit); 
+static inline uint32_t finish_op(State& state, const Instruction& instruction, uint16_t prev_pc)
+{
     state.instructions_executed++;
 
     if (state.pc != prev_pc && instruction.branch_cycles != 0) {
@@ -91,6 +76,105 @@ uint32_t execute_op(State& state)
     }
 }
 
+#ifdef THREADED_OPS
+#ifndef __GNUC__
+#error "THREADED_OPS needs the labels as values extension of GCC or Clang"
+#endif
+
+template <uint16_t OPCODE>
+__attribute__((always_inline)) inline uint32_t execute_threaded_op(State& state, const OpCode& op_code)
+{
+    constexpr const Instruction& instruction = decode_instruction(OPCODE);
+    state.pc += instruction.bytes;
+    uint16_t prev_pc = state.pc;
+    execute_specialized_op<OPCODE>(state, op_code);
+    return finish_op(state, instruction, prev_pc);
+}
+
+/* Expands F(row, column) for all 0x200 opcodes, 0x100-0x1ff being the CB-prefixed ones. */
+#define THREADED_ROW(F, h) \
+    F(h, 0) F(h, 1) F(h, 2) F(h, 3) F(h, 4) F(h, 5) F(h, 6) F(h, 7) \
+    F(h, 8) F(h, 9) F(h, a) F(h, b) F(h, c) F(h, d) F(h, e) F(h, f)
+#define THREADED_TABLE(F) \
+    THREADED_ROW(F, 00) THREADED_ROW(F, 01) THREADED_ROW(F, 02) THREADED_ROW(F, 03) \
+    THREADED_ROW(F, 04) THREADED_ROW(F, 05) THREADED_ROW(F, 06) THREADED_ROW(F, 07) \
+    THREADED_ROW(F, 08) THREADED_ROW(F, 09) THREADED_ROW(F, 0a) THREADED_ROW(F, 0b) \
+    THREADED_ROW(F, 0c) THREADED_ROW(F, 0d) THREADED_ROW(F, 0e) THREADED_ROW(F, 0f) \
+    THREADED_ROW(F, 10) THREADED_ROW(F, 11) THREADED_ROW(F, 12) THREADED_ROW(F, 13) \
+    THREADED_ROW(F, 14) THREADED_ROW(F, 15) THREADED_ROW(F, 16) THREADED_ROW(F, 17) \
+    THREADED_ROW(F, 18) THREADED_ROW(F, 19) THREADED_ROW(F, 1a) THREADED_ROW(F, 1b) \
+    THREADED_ROW(F, 1c) THREADED_ROW(F, 1d) THREADED_ROW(F, 1e) THREADED_ROW(F, 1f)
+#define THREADED_LABEL(h, l) &&op_##h##l,
+#define THREADED_CASE(h, l) op_##h##l: return execute_threaded_op<0x##h##l>(state, op_code);
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+/* Fetch, decode and dispatch in one function. Every opcode has its own label
+ * that calls its specialised handler directly and computes its cycles with the
+ * descriptor known at compile time. */
+uint32_t execute_op(State& state)
+{
+    static void* const labels[0x200] = {THREADED_TABLE(THREADED_LABEL)};
+
+    OpCode op_code{0, 0, 0};
+    uint8_t op = state.read_memory(state.pc);
+    uint16_t opcode = op;
+    op_code[0] = op;
+    if (op == 0xcb) {
+	op_code[1] = state.read_memory(state.pc + 1);
+	opcode = 0x100 | op_code[1];
+    } else {
+        for (uint8_t i = 1; i < ops[op].bytes; i++) {
+	    op_code[i] = state.read_memory(state.pc + i);
+        }
+    }
+    check_op(state, op_code);
+
+    goto *labels[opcode];
+    THREADED_TABLE(THREADED_CASE)
+}
+#pragma GCC diagnostic pop
+#else
+uint32_t execute_op(State& state)
+{
+    OpCode op_code{0, 0, 0};
+    uint16_t opcode = fetch_op(state, state.pc, op_code);
+    return execute_decoded_op(state, opcode, op_code);
+}
+#endif
+
+uint16_t fetch_op(State& state, uint16_t addr, OpCode& op_code)
+{
+    uint8_t op = state.read_memory(addr);
+    op_code[0] = op;
+
+    if (op == 0xcb) {
+	op_code[1] = state.read_memory(addr + 1);
+	return 0x100 | op_code[1];
+    }
+    for (uint8_t i = 1; i < ops[op].bytes; i++) {
+	op_code[i] = state.read_memory(addr + i);
+    }
+    return op;
+}
+
+uint32_t execute_decoded_op(State& state, uint16_t opcode, const OpCode& op_code)
+{
+    const Instruction& instruction = decode_instruction(opcode);
+    check_op(state, op_code);
+
+    state.pc += instruction.bytes;
+    uint16_t prev_pc = state.pc;
+
+#ifdef GENERIC_OPS
+    auto operands = instruction.function(state, instruction, op_code);
+    defer_flags(state, opcode, operands);
+#else
+    specialized_ops[opcode](state, op_code);
+#endif
+    return finish_op(state, instruction, prev_pc);
+}
+
 bool address_executable(uint16_t addr)
 {
     if (addr >= 0x104 && addr <= 0x14f) {
@@ -124,169 +208,214 @@ bool check_carry(pair<uint16_t, uint16_t> operands,
     }
 }
 
-void update_flag(State& state, uint8_t flag_bit, FlagEffect& effect, bool value)
+void update_flag(State& state, uint8_t flag_bit, const Instruction& instruction, bool value)
 {
-    switch (effect) {
-    case FlagEffect::APPLY:
+    if (instruction.flags_apply & flag_bit) {
 	if (value) {
-	    state.f |= flag_bit;
+	    state.registers[REG_F] |= flag_bit;
 	} else {
-            state.f &= ~flag_bit;
+            state.registers[REG_F] &= ~flag_bit;
 	}
-	break;
-    case FlagEffect::SET:
-	state.f |= flag_bit;
-	break;
-    case FlagEffect::CLEAR:
-	state.f &= ~flag_bit;
-	break;
-    case FlagEffect::IGNORE:
-	break;
+    } else if (instruction.flags_set & flag_bit) {
+	state.registers[REG_F] |= flag_bit;
+    } else if (instruction.flags_clear & flag_bit) {
+	state.registers[REG_F] &= ~flag_bit;
     }
 }
 
-void update_flags(State& state, vector<uint8_t>& op_code,
-		  pair<uint16_t, uint16_t> operands, bool is_16_bit)
+void update_flags(State& state, uint16_t opcode, pair<uint16_t, uint16_t> operands)
 {
     uint16_t num1 = operands.first, num2 = operands.second;
 
-    if (op_code[0] == 0xf1) { /* POP AF */
+    if (opcode == 0xf1) { /* POP AF */
 	return;
     }
 
-    Instruction& i = op_code[0] == 0xcb ? ops_cb[op_code[1]] : ops[op_code[0]];
-    uint32_t result = i.flags_ZNHC[1] == FlagEffect::SET ? num1 - num2 : num1 + num2;
-    if (i.name == "DAA") {
-	result = (state.f & FLAG_N) ? num1 - num2 : num1 + num2;
+    const Instruction& i = decode_instruction(opcode);
+    bool is_16_bit = opcode < 0x100 && (opcode & 0xcf) == 0x09; /* ADD HL, rr */
+    uint32_t result = (i.flags_set & FLAG_N) ? num1 - num2 : num1 + num2;
+    if (i.function == &DAA) {
+	result = (state.registers[REG_F] & FLAG_N) ? num1 - num2 : num1 + num2;
     }
 
-    bool rotate_op = (op_code[0] & 0xe7) == 7 || (op_code[0] == 0xcb && i.flags_ZNHC[3] == FlagEffect::APPLY);
+    bool rotate_op = opcode < 0x100 ? (opcode & 0xe7) == 7 : (i.flags_apply & FLAG_C) != 0;
 
     uint8_t half_carry_bit = is_16_bit ? 11 : 3;
     uint8_t carry_bit = is_16_bit ? 15 : 7;
 
-    update_flag(state, FLAG_Z, i.flags_ZNHC[0], (result & (is_16_bit ? 0xffff : 0xff)) == 0);
-    update_flag(state, FLAG_N, i.flags_ZNHC[1], false);
+    update_flag(state, FLAG_Z, i, (result & (is_16_bit ? 0xffff : 0xff)) == 0);
+    update_flag(state, FLAG_N, i, false);
 
-    if (i.name == "ADC" || i.name == "SBC") {
-        if ((num2 & 0xff) == 0 && state.f & FLAG_C) {
-	    state.f |= FLAG_H | FLAG_C;
+    if (i.function == &ADC || i.function == &SBC) {
+        if ((num2 & 0xff) == 0 && state.registers[REG_F] & FLAG_C) {
+	    state.registers[REG_F] |= FLAG_H | FLAG_C;
 	    return;
-	} else if ((num2 & 0xf) == 0 && state.f & FLAG_C) {
-            update_flag(state, FLAG_C, i.flags_ZNHC[3], check_carry(operands, carry_bit, state.f));
-	    state.f |= FLAG_H;
+	} else if ((num2 & 0xf) == 0 && state.registers[REG_F] & FLAG_C) {
+            update_flag(state, FLAG_C, i, check_carry(operands, carry_bit, state.registers[REG_F]));
+	    state.registers[REG_F] |= FLAG_H;
 	    return;
 	}
     }
 
-    update_flag(state, FLAG_H, i.flags_ZNHC[2], check_carry(operands, half_carry_bit, state.f));
-    if (!rotate_op && i.name != "CCF" && i.name != "DAA" && i.name != "SRA") {
+    update_flag(state, FLAG_H, i, check_carry(operands, half_carry_bit, state.registers[REG_F]));
+    if (!rotate_op && i.function != &CCF && i.function != &DAA && i.function != &SRA) {
 	/* Carry flag is set elsewhere for rotation/shift ops. */
-        update_flag(state, FLAG_C, i.flags_ZNHC[3], check_carry(operands, carry_bit, state.f));
+        update_flag(state, FLAG_C, i, check_carry(operands, carry_bit, state.registers[REG_F]));
     }
 }
 
-uint16_t uint8_to_uint16(uint8_t high, uint8_t low)
+void evaluate_flags(State& state)
 {
-    return high << 8 | low;
+    if (state.flags_pending) {
+	state.flags_pending = false;
+	update_flags(state, state.pending_flags_opcode, state.pending_flags_operands);
+    }
 }
 
-uint16_t read_register_pair(State& state, const string& register_name)
+uint8_t read_flags(State& state)
 {
-    auto& register_pair = state.register_pairs[register_name];
-    return uint8_to_uint16(*register_pair.first, *register_pair.second);
+    evaluate_flags(state);
+    return state.registers[REG_F];
 }
 
-void write_register_pair(State& state, const string& register_name, uint16_t value)
+void defer_flags(State& state, uint16_t opcode, pair<uint16_t, uint16_t> operands)
 {
-    *state.register_pairs[register_name].first = value >> 8 & 0xff;
-    *state.register_pairs[register_name].second = value & 0xff;
+    const Instruction& i = decode_instruction(opcode);
+    uint8_t affected = i.flags_apply | i.flags_set | i.flags_clear;
+    if (opcode == 0xf1 || affected == 0) { /* POP AF writes F itself */
+	return;
+    }
+
+    /* A pending result can only be dropped if this instruction replaces every flag.
+     * Handlers that read F evaluate pending flags before running. */
+    if (affected != (FLAG_Z | FLAG_N | FLAG_H | FLAG_C)) {
+	evaluate_flags(state);
+    }
+
+    if (i.flags_apply == 0) {
+	state.registers[REG_F] = (state.registers[REG_F] & ~i.flags_clear) | i.flags_set;
+	state.flags_pending = false;
+    } else {
+	state.flags_pending = true;
+	state.pending_flags_opcode = opcode;
+	state.pending_flags_operands = operands;
+    }
 }
 
-uint16_t read_operand(State& state, const string& operand_name, vector<uint8_t>& op_code)
+uint16_t uint8_to_uint16(uint8_t high, uint8_t low)
 {
-    uint16_t value = 0;
-    if (state.registers.find(operand_name) != state.registers.end()) {
-	value = *state.registers[operand_name];
-    } else if (state.register_pairs.find(operand_name) != state.register_pairs.end()) {
-	value = read_register_pair(state, operand_name);
-    } else if (operand_name == "d8") {
-	value = op_code[1];
-    } else if (operand_name == "d16") {
-	value = uint8_to_uint16(op_code[2], op_code[1]);
-    } else if (operand_name == "a16") {
-	value = uint8_to_uint16(op_code[2], op_code[1]);
-    } else if (operand_name == "r8") {
-	/* Needs to be converted to signed when used */
-	value = op_code[1];
-    } else if (operand_name == "SP") {
-	value = state.sp;
-    } else if (operand_name == "SP+r8") {
-	value = state.sp + (int8_t) op_code[1];
-    } else if (operand_name.length() == 3 && operand_name[2] == 'H') {
-	sscanf(operand_name.substr(0, 2).c_str(), "%" SCNx16, &value);
-    } else if (operand_name.front() == '(' && operand_name.back() == ')') {
-	string location = operand_name.substr(1, operand_name.length() - 2);
-	uint16_t addr = 0;
-	if (state.register_pairs.find(location) != state.register_pairs.end()) {
-	    addr = read_register_pair(state, location.c_str());
-	} else if (location == "HL+") {
-	    addr = read_register_pair(state, "HL");
-	    write_register_pair(state, "HL", read_register_pair(state, "HL") + 1);
-	} else if (location == "HL-") {
-	    addr = read_register_pair(state, "HL");
-	    write_register_pair(state, "HL", read_register_pair(state, "HL") - 1);
-	} else if (location == "a8") {
-	    addr = uint8_to_uint16(0xff, op_code[1]);
-	} else if (location == "a16") {
-	    addr = uint8_to_uint16(op_code[2], op_code[1]);
-	} else if (location == "C") {
-	    addr = uint8_to_uint16(0xff, state.c);
-	}
-	value = state.read_memory(addr);
-    }
-    return value;
+    return high << 8 | low;
+}
+
+uint16_t read_register_pair(State& state, uint8_t index)
+{
+    if (index == PAIR_AF) {evaluate_flags(state);}
+    return state.read_pair(index);
+}
+
+void write_register_pair(State& state, uint8_t index, uint16_t value)
+{
+    if (index == PAIR_AF) {state.flags_pending = false;}
+    state.write_pair(index, value);
 }
 
-void write_operand(State& state, const string& operand_name, vector<uint8_t>& op_code, uint16_t value)
+uint16_t operand_address(State& state, const Operand& operand, const OpCode& op_code)
 {
-    if (state.registers.find(operand_name) != state.registers.end()) {
-	*state.registers[operand_name] = value;
-    } else if (state.register_pairs.find(operand_name) != state.register_pairs.end()) {
-	write_register_pair(state, operand_name, value);
-    } else if (operand_name == "SP") {
+    uint16_t addr = 0;
+    switch (operand.kind) {
+    case OperandKind::MEM_REGISTER_PAIR:
+	addr = read_register_pair(state, operand.value);
+	break;
+    case OperandKind::MEM_HL_INC:
+	addr = read_register_pair(state, PAIR_HL);
+	write_register_pair(state, PAIR_HL, addr + 1);
+	break;
+    case OperandKind::MEM_HL_DEC:
+	addr = read_register_pair(state, PAIR_HL);
+	write_register_pair(state, PAIR_HL, addr - 1);
+	break;
+    case OperandKind::MEM_A8:
+	addr = uint8_to_uint16(0xff, op_code[1]);
+	break;
+    case OperandKind::MEM_A16:
+	addr = uint8_to_uint16(op_code[2], op_code[1]);
+	break;
+    case OperandKind::MEM_C:
+	addr = uint8_to_uint16(0xff, state.registers[REG_C]);
+	break;
+    default:
+	break;
+    }
+    return addr;
+}
+
+uint16_t read_operand(State& state, const Operand& operand, const OpCode& op_code)
+{
+    switch (operand.kind) {
+    case OperandKind::REGISTER:
+	return state.registers[operand.value];
+    case OperandKind::REGISTER_PAIR:
+	return read_register_pair(state, operand.value);
+    case OperandKind::SP:
+	return state.sp;
+    case OperandKind::D8:
+    case OperandKind::R8:
+	/* r8 needs to be converted to signed when used */
+	return op_code[1];
+    case OperandKind::D16:
+    case OperandKind::A16:
+	return uint8_to_uint16(op_code[2], op_code[1]);
+    case OperandKind::SP_R8:
+	return state.sp + (int8_t) op_code[1];
+    case OperandKind::LITERAL:
+	return operand.value;
+    case OperandKind::MEM_REGISTER_PAIR:
+    case OperandKind::MEM_HL_INC:
+    case OperandKind::MEM_HL_DEC:
+    case OperandKind::MEM_A8:
+    case OperandKind::MEM_A16:
+    case OperandKind::MEM_C:
+	return state.read_memory(operand_address(state, operand, op_code));
+    default:
+	return 0;
+    }
+}
+
+void write_operand(State& state, const Operand& operand, const OpCode& op_code, uint16_t value)
+{
+    switch (operand.kind) {
+    case OperandKind::REGISTER:
+	state.registers[operand.value] = value;
+	break;
+    case OperandKind::REGISTER_PAIR:
+	write_register_pair(state, operand.value, value);
+	break;
+    case OperandKind::SP:
 	state.sp = value;
-    } else if (operand_name.front() == '(' && operand_name.back() == ')') {
-	string location = operand_name.substr(1, operand_name.size() - 2);
-	uint16_t addr = 0;
-	if (state.register_pairs.find(location) != state.register_pairs.end()) {
-	    addr = read_register_pair(state, location.c_str());
-	} else if (location == "HL+") {
-	    addr = read_register_pair(state, "HL");
-	    write_register_pair(state, "HL", read_register_pair(state, "HL") + 1);
-	} else if (location == "HL-") {
-	    addr = read_register_pair(state, "HL");
-	    write_register_pair(state, "HL", read_register_pair(state, "HL") - 1);
-	} else if (location == "a8") {
-	    addr = uint8_to_uint16(0xff, op_code[1]);
-	} else if (location == "a16") {
-	    addr = uint8_to_uint16(op_code[2], op_code[1]);
-	} else if (location == "C") {
-	    addr = uint8_to_uint16(0xff, state.c);
-	}
-	state.write_memory(addr, value);
+	break;
+    case OperandKind::MEM_REGISTER_PAIR:
+    case OperandKind::MEM_HL_INC:
+    case OperandKind::MEM_HL_DEC:
+    case OperandKind::MEM_A8:
+    case OperandKind::MEM_A16:
+    case OperandKind::MEM_C:
+	state.write_memory(operand_address(state, operand, op_code), value);
+	break;
+    default:
+	break;
     }
 }
 
-bool check_condition(State& state, string& condition_code)
+bool check_condition(State& state, const Operand& condition)
 {
-	bool condition = false;
-	switch (condition_code.back()) {
-	case 'Z': condition = (state.f & FLAG_Z) != 0; break;
-	case 'C': condition = (state.f & FLAG_C) != 0; break;
+	evaluate_flags(state);
+	switch (condition.value) {
+	case COND_NZ: return (state.registers[REG_F] & FLAG_Z) == 0;
+	case COND_Z: return (state.registers[REG_F] & FLAG_Z) != 0;
+	case COND_NC: return (state.registers[REG_F] & FLAG_C) == 0;
+	case COND_C: return (state.registers[REG_F] & FLAG_C) != 0;
 	}
-	if (condition_code.front() == 'N') {condition = !condition;}
-	return condition;
+	return false;
 }
 
 uint16_t pop_from_stack(State& state)
@@ -310,12 +439,12 @@ void push_onto_stack(State& state, uint16_t value)
     state.stack_depth++;
 }
 
-pair<uint16_t, uint16_t> LD(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> LD(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     uint16_t num1 = 0, num2 = 0;
     uint16_t value = read_operand(state, instruction.operand2, op_code);
 
-    if (op_code[0] == 0x8) {
+    if (instruction.operand2.kind == OperandKind::SP) { /* LD (a16), SP */
         uint16_t addr = uint8_to_uint16(op_code[2], op_code[1]);
 	state.write_memory(addr, state.sp & 0xff);
 	state.write_memory(addr + 1, (state.sp >> 8) & 0xff);
@@ -323,29 +452,29 @@ pair<uint16_t, uint16_t> LD(State& state, Instruction& instruction, vector<uint8
         write_operand(state, instruction.operand1, op_code, value);
     }
 
-    if (op_code[0] == 0xf8) {
+    if (instruction.operand2.kind == OperandKind::SP_R8) {
         num1 = state.sp;
 	num2 = op_code[1];
     }
     return make_pair(num1, num2);
 }
 
-pair<uint16_t, uint16_t> POP(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> POP(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     uint16_t value = pop_from_stack(state);
-    write_register_pair(state, (const string) instruction.operand1, value);
-    if (op_code[0] == 0xf1) {state.f &= 0xf0;}
+    write_register_pair(state, instruction.operand1.value, value);
+    if (instruction.operand1.value == PAIR_AF) {state.registers[REG_F] &= 0xf0;}
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> PUSH(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> PUSH(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    uint16_t value = read_register_pair(state, (const string) instruction.operand1);
+    uint16_t value = read_register_pair(state, instruction.operand1.value);
     push_onto_stack(state, value);
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> INC(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> INC(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     uint16_t num1 = 0, num2 = 1;
     num1 = read_operand(state, instruction.operand1, op_code);
@@ -354,7 +483,7 @@ pair<uint16_t, uint16_t> INC(State& state, Instruction& instruction, vector<uint
     return make_pair(num1, num2);
 }
 
-pair<uint16_t, uint16_t> DEC(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> DEC(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     uint16_t num1 = 0, num2 = 1;
     num1 = read_operand(state, instruction.operand1, op_code);
@@ -363,33 +492,34 @@ pair<uint16_t, uint16_t> DEC(State& state, Instruction& instruction, vector<uint
     return make_pair(num1, num2);
 }
 
-pair<uint16_t, uint16_t> DAA(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> DAA(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    uint16_t num1 = state.a, num2 = 0;
-    if (state.f & FLAG_C || ((state.f & FLAG_N) == 0 && state.a > 0x99)) {
+    evaluate_flags(state);
+    uint16_t num1 = state.registers[REG_A], num2 = 0;
+    if (state.registers[REG_F] & FLAG_C || ((state.registers[REG_F] & FLAG_N) == 0 && state.registers[REG_A] > 0x99)) {
 	num2 += 0x60;
-	state.f |= FLAG_C;
+	state.registers[REG_F] |= FLAG_C;
     }
-    if (state.f & FLAG_H || ((state.f & FLAG_N) == 0 && (state.a & 0xf) > 0x9)) {
+    if (state.registers[REG_F] & FLAG_H || ((state.registers[REG_F] & FLAG_N) == 0 && (state.registers[REG_A] & 0xf) > 0x9)) {
 	num2 += 6;
     }
-    state.a += state.f & FLAG_N ? -num2 : num2;
+    state.registers[REG_A] += state.registers[REG_F] & FLAG_N ? -num2 : num2;
     return make_pair(num1, num2);
 }
 
-pair<uint16_t, uint16_t> CPL(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> CPL(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    state.a = ~state.a;
-    return make_pair(state.a, 0);
+    state.registers[REG_A] = ~state.registers[REG_A];
+    return make_pair(state.registers[REG_A], 0);
 }
 
-pair<uint16_t, uint16_t> ADD(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> ADD(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     uint16_t value = 0;
     uint16_t num1 = read_operand(state, instruction.operand1, op_code);
     uint16_t num2 = read_operand(state, instruction.operand2, op_code);
 
-    if (instruction.operand2 == "r8") {
+    if (instruction.operand2.kind == OperandKind::R8) {
 	value = num1 + (int8_t) num2;
     } else {
 	value = num1 + num2;
@@ -400,61 +530,63 @@ pair<uint16_t, uint16_t> ADD(State& state, Instruction& instruction, vector<uint
     return make_pair(num1, num2);
 }
 
-pair<uint16_t, uint16_t> ADC(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> ADC(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    uint16_t num1 = state.a;
+    evaluate_flags(state);
+    uint16_t num1 = state.registers[REG_A];
     uint16_t num2 = read_operand(state, instruction.operand2, op_code);
-    num2 += (state.f & FLAG_C) ? 1 : 0;
-    state.a += num2;
+    num2 += (state.registers[REG_F] & FLAG_C) ? 1 : 0;
+    state.registers[REG_A] += num2;
     return make_pair(num1, num2);
 }
 
-pair<uint16_t, uint16_t> SUB(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> SUB(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    uint16_t num1 = state.a;
+    uint16_t num1 = state.registers[REG_A];
     uint16_t num2 = read_operand(state, instruction.operand1, op_code);
-    state.a -= num2;
+    state.registers[REG_A] -= num2;
     return make_pair(num1, num2);
 }
 
-pair<uint16_t, uint16_t> SBC(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> SBC(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    uint16_t num1 = state.a;
+    evaluate_flags(state);
+    uint16_t num1 = state.registers[REG_A];
     uint16_t num2 = read_operand(state, instruction.operand2, op_code);
-    num2 += (state.f & FLAG_C) ? 1 : 0;
-    state.a -= num2;
+    num2 += (state.registers[REG_F] & FLAG_C) ? 1 : 0;
+    state.registers[REG_A] -= num2;
     return make_pair(num1, num2);
 }
 
-pair<uint16_t, uint16_t> AND(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> AND(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     uint16_t num2 = read_operand(state, instruction.operand1, op_code);
-    state.a &= num2;
-    return make_pair(state.a, 0);
+    state.registers[REG_A] &= num2;
+    return make_pair(state.registers[REG_A], 0);
 }
 
-pair<uint16_t, uint16_t> XOR(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> XOR(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     uint16_t num2 = read_operand(state, instruction.operand1, op_code);
-    state.a ^= num2;
-    return make_pair(state.a, 0);
+    state.registers[REG_A] ^= num2;
+    return make_pair(state.registers[REG_A], 0);
 }
 
-pair<uint16_t, uint16_t> OR(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> OR(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     uint16_t num2 = read_operand(state, instruction.operand1, op_code);
-    state.a |= num2;
-    return make_pair(state.a, 0);
+    state.registers[REG_A] |= num2;
+    return make_pair(state.registers[REG_A], 0);
 }
 
-pair<uint16_t, uint16_t> CP(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> CP(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    uint16_t num1 = state.a;
+    uint16_t num1 = state.registers[REG_A];
     uint16_t num2 = read_operand(state, instruction.operand1, op_code);
     return make_pair(num1, num2);
 }
 
-pair<uint16_t, uint16_t> JR(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> JR(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     bool jump = instruction.operand_count == 1;
     jump = jump || check_condition(state, instruction.operand1);
@@ -465,14 +597,14 @@ pair<uint16_t, uint16_t> JR(State& state, Instruction& instruction, vector<uint8
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> JP(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> JP(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     bool jump = instruction.operand_count == 1;
     jump = jump || check_condition(state, instruction.operand1);
 
     if (jump) {
-	if (instruction.operand1 == "(HL)") {
-	    state.pc = read_register_pair(state, "HL");
+	if (instruction.operand1.kind == OperandKind::MEM_REGISTER_PAIR) {
+	    state.pc = read_register_pair(state, PAIR_HL);
 	} else {
             state.pc = uint8_to_uint16(op_code[2], op_code[1]);
 	}
@@ -480,7 +612,7 @@ pair<uint16_t, uint16_t> JP(State& state, Instruction& instruction, vector<uint8
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> RET(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> RET(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     bool jump = instruction.operand_count == 0;
     jump = jump || check_condition(state, instruction.operand1);
@@ -491,7 +623,7 @@ pair<uint16_t, uint16_t> RET(State& state, Instruction& instruction, vector<uint
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> RETI(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> RETI(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     bool jump = instruction.operand_count == 0;
     jump = jump || check_condition(state, instruction.operand1);
@@ -499,11 +631,11 @@ pair<uint16_t, uint16_t> RETI(State& state, Instruction& instruction, vector<uin
     if (jump) {
         state.pc = pop_from_stack(state);
     }
-    state.interrupts_enabled = true;
+    state.interrupts.enable();
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> CALL(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> CALL(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     bool jump = instruction.operand_count == 1;
     jump = jump || check_condition(state, instruction.operand1);
@@ -515,70 +647,75 @@ pair<uint16_t, uint16_t> CALL(State& state, Instruction& instruction, vector<uin
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> RST(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> RST(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     push_onto_stack(state, state.pc);
     state.pc = read_operand(state, instruction.operand1, op_code);
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> RLCA(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> RLCA(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    uint8_t bit7 = (state.a & 0x80) >> 7;
+    evaluate_flags(state);
+    uint8_t bit7 = (state.registers[REG_A] & 0x80) >> 7;
     if (bit7 != 0) {
-        state.f |= FLAG_C;
+        state.registers[REG_F] |= FLAG_C;
     } else {
-        state.f &= ~FLAG_C;
+        state.registers[REG_F] &= ~FLAG_C;
     }
-    state.a = (state.a << 1) | bit7;
+    state.registers[REG_A] = (state.registers[REG_A] << 1) | bit7;
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> RLA(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> RLA(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    uint8_t old_a = state.a;
-    state.a = (state.a << 1) | ((state.f & FLAG_C) ? 1 : 0);
+    evaluate_flags(state);
+    uint8_t old_a = state.registers[REG_A];
+    state.registers[REG_A] = (state.registers[REG_A] << 1) | ((state.registers[REG_F] & FLAG_C) ? 1 : 0);
     if (old_a & 0x80) {
-        state.f |= FLAG_C;
+        state.registers[REG_F] |= FLAG_C;
     } else {
-        state.f &= ~FLAG_C;
+        state.registers[REG_F] &= ~FLAG_C;
     }
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> RRCA(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> RRCA(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    uint8_t bit0 = (state.a & 1) << 7;
+    evaluate_flags(state);
+    uint8_t bit0 = (state.registers[REG_A] & 1) << 7;
     if (bit0 != 0) {
-        state.f |= FLAG_C;
+        state.registers[REG_F] |= FLAG_C;
     } else {
-        state.f &= ~FLAG_C;
+        state.registers[REG_F] &= ~FLAG_C;
     }
-    state.a = (state.a >> 1) | bit0;
+    state.registers[REG_A] = (state.registers[REG_A] >> 1) | bit0;
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> RRA(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> RRA(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    uint8_t old_a = state.a;
-    state.a = (state.a >> 1) | ((state.f & FLAG_C) ? 0x80 : 0);
+    evaluate_flags(state);
+    uint8_t old_a = state.registers[REG_A];
+    state.registers[REG_A] = (state.registers[REG_A] >> 1) | ((state.registers[REG_F] & FLAG_C) ? 0x80 : 0);
     if (old_a & 1) {
-        state.f |= FLAG_C;
+        state.registers[REG_F] |= FLAG_C;
     } else {
-        state.f &= ~FLAG_C;
+        state.registers[REG_F] &= ~FLAG_C;
     }
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> RLC(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> RLC(State& state, const Instruction& instruction, const OpCode& op_code)
 {
+    evaluate_flags(state);
     uint8_t value = read_operand(state, instruction.operand1, op_code);
 
     uint8_t bit7 = (value & 0x80) >> 7;
     if (bit7 != 0) {
-        state.f |= FLAG_C;
+        state.registers[REG_F] |= FLAG_C;
     } else {
-        state.f &= ~FLAG_C;
+        state.registers[REG_F] &= ~FLAG_C;
     }
     value = (value << 1) | bit7;
 
@@ -586,15 +723,16 @@ pair<uint16_t, uint16_t> RLC(State& state, Instruction& instruction, vector<uint
     return make_pair(value, 0);
 }
 
-pair<uint16_t, uint16_t> RRC(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> RRC(State& state, const Instruction& instruction, const OpCode& op_code)
 {
+    evaluate_flags(state);
     uint8_t value = read_operand(state, instruction.operand1, op_code);
 
     uint8_t bit0 = (value & 1) << 7;
     if (bit0 != 0) {
-        state.f |= FLAG_C;
+        state.registers[REG_F] |= FLAG_C;
     } else {
-        state.f &= ~FLAG_C;
+        state.registers[REG_F] &= ~FLAG_C;
     }
     value = (value >> 1) | bit0;
 
@@ -602,46 +740,49 @@ pair<uint16_t, uint16_t> RRC(State& state, Instruction& instruction, vector<uint
     return make_pair(value, 0);
 }
 
-pair<uint16_t, uint16_t> RL(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> RL(State& state, const Instruction& instruction, const OpCode& op_code)
 {
+    evaluate_flags(state);
     uint8_t value = read_operand(state, instruction.operand1, op_code);
     uint8_t old_value = value;
  
-    value = (value << 1) | ((state.f & FLAG_C) ? 1 : 0);
+    value = (value << 1) | ((state.registers[REG_F] & FLAG_C) ? 1 : 0);
     if (old_value & 0x80) {
-        state.f |= FLAG_C;
+        state.registers[REG_F] |= FLAG_C;
     } else {
-        state.f &= ~FLAG_C;
+        state.registers[REG_F] &= ~FLAG_C;
     }
 
     write_operand(state, instruction.operand1, op_code, value);
     return make_pair(value, 0);
 }
 
-pair<uint16_t, uint16_t> RR(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> RR(State& state, const Instruction& instruction, const OpCode& op_code)
 {
+    evaluate_flags(state);
     uint8_t value = read_operand(state, instruction.operand1, op_code);
     uint8_t old_value = value;
  
-    value = (value >> 1) | ((state.f & FLAG_C) ? 0x80 : 0);
+    value = (value >> 1) | ((state.registers[REG_F] & FLAG_C) ? 0x80 : 0);
     if (old_value & 1) {
-        state.f |= FLAG_C;
+        state.registers[REG_F] |= FLAG_C;
     } else {
-        state.f &= ~FLAG_C;
+        state.registers[REG_F] &= ~FLAG_C;
     }
 
     write_operand(state, instruction.operand1, op_code, value);
     return make_pair(value, 0);
 }
 
-pair<uint16_t, uint16_t> SLA(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> SLA(State& state, const Instruction& instruction, const OpCode& op_code)
 {
+    evaluate_flags(state);
     uint8_t value = read_operand(state, instruction.operand1, op_code);
 
     if (value & 0x80) {
-        state.f |= FLAG_C;
+        state.registers[REG_F] |= FLAG_C;
     } else {
-        state.f &= ~FLAG_C;
+        state.registers[REG_F] &= ~FLAG_C;
     }
     value = value << 1;
 
@@ -649,14 +790,15 @@ pair<uint16_t, uint16_t> SLA(State& state, Instruction& instruction, vector<uint
     return make_pair(value, 0);
 }
 
-pair<uint16_t, uint16_t> SRA(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> SRA(State& state, const Instruction& instruction, const OpCode& op_code)
 {
+    evaluate_flags(state);
     uint8_t value = read_operand(state, instruction.operand1, op_code);
 
     if (value & 1) {
-        state.f |= FLAG_C;
+        state.registers[REG_F] |= FLAG_C;
     } else {
-        state.f &= ~FLAG_C;
+        state.registers[REG_F] &= ~FLAG_C;
     }
     value = (value & 0x80) | (value >> 1);
 
@@ -664,14 +806,15 @@ pair<uint16_t, uint16_t> SRA(State& state, Instruction& instruction, vector<uint
     return make_pair(value, 0);
 }
 
-pair<uint16_t, uint16_t> SRL(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> SRL(State& state, const Instruction& instruction, const OpCode& op_code)
 {
+    evaluate_flags(state);
     uint8_t value = read_operand(state, instruction.operand1, op_code);
 
     if (value & 1) {
-        state.f |= FLAG_C;
+        state.registers[REG_F] |= FLAG_C;
     } else {
-        state.f &= ~FLAG_C;
+        state.registers[REG_F] &= ~FLAG_C;
     }
     value = value >> 1;
 
@@ -679,7 +822,7 @@ pair<uint16_t, uint16_t> SRL(State& state, Instruction& instruction, vector<uint
     return make_pair(value, 0);
 }
 
-pair<uint16_t, uint16_t> SWAP(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> SWAP(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     uint8_t value = read_operand(state, instruction.operand1, op_code);
     value = (value & 0xf) << 4 | (value & 0xf0) >> 4;
@@ -687,11 +830,10 @@ pair<uint16_t, uint16_t> SWAP(State& state, Instruction& instruction, vector<uin
     return make_pair(value, 0);
 }
 
-pair<uint16_t, uint16_t> BIT(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> BIT(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     uint8_t value = read_operand(state, instruction.operand2, op_code);
-    uint8_t bit = 0;
-    sscanf(instruction.operand1.c_str(), "%" SCNx8, &bit);
+    uint8_t bit = instruction.operand1.value;
     if (value & (1 << bit)) {
 	return make_pair(1, 0);
     } else {
@@ -699,64 +841,62 @@ pair<uint16_t, uint16_t> BIT(State& state, Instruction& instruction, vector<uint
     }
 }
 
-pair<uint16_t, uint16_t> RES(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> RES(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     uint8_t value = read_operand(state, instruction.operand2, op_code);
-    uint8_t bit = 0;
-    sscanf(instruction.operand1.c_str(), "%" SCNx8, &bit);
+    uint8_t bit = instruction.operand1.value;
     value &= ~(1 << bit);
     write_operand(state, instruction.operand2, op_code, value);
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> SET(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> SET(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     uint8_t value = read_operand(state, instruction.operand2, op_code);
-    uint8_t bit = 0;
-    sscanf(instruction.operand1.c_str(), "%" SCNx8, &bit);
+    uint8_t bit = instruction.operand1.value;
     value |= 1 << bit;
     write_operand(state, instruction.operand2, op_code, value);
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> NOP(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> NOP(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> CCF(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> CCF(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    if (state.f & FLAG_C) {
-	state.f &= ~FLAG_C;
+    evaluate_flags(state);
+    if (state.registers[REG_F] & FLAG_C) {
+	state.registers[REG_F] &= ~FLAG_C;
     } else {
-	state.f |= FLAG_C;
+	state.registers[REG_F] |= FLAG_C;
     }
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> EI(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> EI(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    state.interrupts_enabled = true;
+    state.interrupts.enable_after(state.instructions_executed);
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> DI(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> DI(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    state.interrupts_enabled = false;
+    state.interrupts.disable();
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> HALT(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> HALT(State& state, const Instruction& instruction, const OpCode& op_code)
 {
-    state.halt_mode = true;
+    state.interrupts.halt();
     return make_pair(0, 0);
 }
 
-pair<uint16_t, uint16_t> STOP(State& state, Instruction& instruction, vector<uint8_t>& op_code)
+pair<uint16_t, uint16_t> STOP(State& state, const Instruction& instruction, const OpCode& op_code)
 {
     if (state.prepare_double_speed) {
-        state.prepare_double_speed = false;
-        state.double_speed = true;
+        state.switch_speed();
     } else {
         state.stop_mode = true;
     }
@@ -4,79 +4,77 @@
 #include "state.h"
 
 #include <cstdint>
-#include <string>
-#include <unordered_map>
 #include <unordered_set>
 #include <utility>
-#include <vector>
 
-const std::uint8_t FLAG_Z = 0x80;
-const std::uint8_t FLAG_N = 0x40;
-const std::uint8_t FLAG_H = 0x20;
-const std::uint8_t FLAG_C = 0x10;
+extern std::unordered_set<std::uint8_t> invalid_ops;
 
-typedef std::pair<std::uint16_t, std::uint16_t> (*OpFunction)(State&, Instruction&, std::vector<std::uint8_t>&);
-extern std::unordered_map<std::string, OpFunction> op_functions;
-extern std::unordered_set<std::uint8_t> invalid_op;
-extern std::unordered_set<std::uint8_t> ops_16b;
+typedef void (*SpecializedOpFunction)(State&, const OpCode&);
 
 std::uint32_t execute_op(State& state);
+std::uint16_t fetch_op(State& state, std::uint16_t addr, OpCode& op_code);
+std::uint32_t execute_decoded_op(State& state, std::uint16_t opcode, const OpCode& op_code);
 bool address_executable(std::uint16_t addr);
 
 bool check_carry(std::pair<std::uint16_t, std::uint16_t> operands,
 		 std::uint8_t carry_bit, std::uint8_t flags);
-void update_flag(State& state, std::uint8_t flag_bit, FlagEffect& effect, bool value);
-void update_flags(State& state, std::vector<std::uint8_t>& op_code,
-		  std::pair<std::uint16_t, std::uint16_t> operands, bool uint16);
+void update_flag(State& state, std::uint8_t flag_bit, const Instruction& instruction, bool value);
+void update_flags(State& state, std::uint16_t opcode,
+		  std::pair<std::uint16_t, std::uint16_t> operands);
+void evaluate_flags(State& state);
+std::uint8_t read_flags(State& state);
+void defer_flags(State& state, std::uint16_t opcode,
+		 std::pair<std::uint16_t, std::uint16_t> operands);
 
 std::uint16_t uint8_to_uint16(std::uint8_t high, std::uint8_t low);
-std::uint16_t read_register_pair(State& state, std::string& register_name);
-void write_register_pair(State& state, std::string& register_name, std::uint16_t value);
-std::uint16_t read_operand(State& state, const std::string& operand_name, std::vector<std::uint8_t>& op_code);
-void write_operand(State& state, const std::string& operand_name, std::vector<std::uint8_t>& op_code, std::uint16_t value);
-bool check_condition(State& state, std::string& condition_code);
+std::uint16_t read_register_pair(State& state, std::uint8_t index);
+void write_register_pair(State& state, std::uint8_t index, std::uint16_t value);
+std::uint16_t operand_address(State& state, const Operand& operand, const OpCode& op_code);
+std::uint16_t read_operand(State& state, const Operand& operand, const OpCode& op_code);
+void write_operand(State& state, const Operand& operand, const OpCode& op_code, std::uint16_t value);
+bool check_condition(State& state, const Operand& condition);
 uint16_t pop_from_stack(State& state);
 void push_onto_stack(State& state, uint16_t value);
 
-std::pair<std::uint16_t, std::uint16_t> LD(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> POP(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> PUSH(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> INC(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> DEC(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> DAA(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> CPL(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> ADD(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> ADC(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> SUB(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> SBC(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> AND(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> XOR(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> OR(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> CP(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> JR(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> JP(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> RET(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> RETI(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> CALL(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> RST(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> RLCA(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> RLA(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> RRCA(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> RRA(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> RLC(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> RRC(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> RL(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> RR(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> SLA(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> SRA(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> SRL(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> SWAP(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> BIT(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> RES(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> SET(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> NOP(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> CCF(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> EI(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> DI(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> HALT(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
-std::pair<std::uint16_t, std::uint16_t> STOP(State& state, Instruction& instruction, std::vector<std::uint8_t>& op_code);
+std::pair<std::uint16_t, std::uint16_t> LD(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> POP(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> PUSH(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> INC(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> DEC(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> DAA(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> CPL(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> ADD(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> ADC(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> SUB(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> SBC(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> AND(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> XOR(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> OR(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> CP(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> JR(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> JP(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> RET(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> RETI(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> CALL(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> RST(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> RLCA(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> RLA(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> RRCA(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> RRA(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> RLC(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> RRC(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> RL(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> RR(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> SLA(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> SRA(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> SRL(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> SWAP(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> BIT(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> RES(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> SET(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> NOP(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> CCF(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> EI(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> DI(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> HALT(State& state, const Instruction& instruction, const OpCode& op_code);
+std::pair<std::uint16_t, std::uint16_t> STOP(State& state, const Instruction& instruction, const OpCode& op_code);
@@ -0,0 +1,194 @@
+#include "rewind.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using std::lock_guard;
+using std::memcpy;
+using std::move;
+using std::mutex;
+using std::size_t;
+using std::thread;
+using std::uint8_t;
+using std::uint64_t;
+using std::unique_lock;
+using std::vector;
+
+RewindBuffer::RewindBuffer(size_t budget, size_t max_frames) : budget(budget),
+                                                             max_frames(max_frames)
+{
+    this->encoder = thread(&RewindBuffer::run, this);
+}
+
+RewindBuffer::~RewindBuffer()
+{
+    {
+        lock_guard<mutex> lock(this->history_mutex);
+        this->stopping = true;
+        this->pending.clear();
+    }
+    this->wake.notify_one();
+    this->encoder.join();
+}
+
+void RewindBuffer::push(vector<uint8_t> snapshot)
+{
+    {
+        lock_guard<mutex> lock(this->history_mutex);
+        this->pending.push_back(move(snapshot));
+    }
+    this->wake.notify_one();
+}
+
+bool RewindBuffer::pop(vector<uint8_t>& snapshot)
+{
+    unique_lock<mutex> lock(this->history_mutex);
+    this->idle.wait(lock, [this] {return this->pending.empty() && !this->encoding;});
+    if (this->head.empty()) {
+        return false;
+    }
+
+    snapshot = this->head;
+    if (this->deltas.empty()) {
+        this->head.clear();
+    } else {
+        apply_xor_delta(this->deltas.back(), this->head.data());
+        this->delta_bytes -= this->deltas.back().size();
+        this->deltas.pop_back();
+    }
+    return true;
+}
+
+size_t RewindBuffer::frames()
+{
+    lock_guard<mutex> lock(this->history_mutex);
+    return this->head.empty() ? 0 : this->deltas.size() + 1;
+}
+
+size_t RewindBuffer::bytes_used()
+{
+    lock_guard<mutex> lock(this->history_mutex);
+    return this->head.size() + this->delta_bytes;
+}
+
+void RewindBuffer::run()
+{
+    vector<uint8_t> snapshot;
+    vector<uint8_t> delta;
+    unique_lock<mutex> lock(this->history_mutex);
+    while (true) {
+        this->wake.wait(lock, [this] {return !this->pending.empty() || this->stopping;});
+        if (this->stopping) {
+            return;
+        }
+        snapshot.swap(this->pending.front());
+        this->pending.pop_front();
+        this->encoding = true;
+
+        /* A state of another size, say after loading another ROM, starts over */
+        lock.unlock();
+        bool continues = this->head.size() == snapshot.size();
+        if (continues) {
+            encode_xor_delta(this->head.data(), snapshot.data(), snapshot.size(), delta);
+        }
+        lock.lock();
+
+        if (!continues) {
+            this->deltas.clear();
+            this->delta_bytes = 0;
+        } else {
+            this->delta_bytes += delta.size();
+            this->deltas.push_back(delta);
+        }
+        this->head.swap(snapshot);
+        while (!this->deltas.empty() && (this->head.size() + this->delta_bytes > this->budget
+                                         || this->deltas.size() + 1 > this->max_frames)) {
+            this->delta_bytes -= this->deltas.front().size();
+            this->deltas.pop_front();
+        }
+
+        this->encoding = false;
+        if (this->pending.empty()) {
+            this->idle.notify_all();
+        }
+    }
+}
+
+static void append_varint(vector<uint8_t>& data, size_t value)
+{
+    while (value >= 0x80) {
+        data.push_back((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    data.push_back(value);
+}
+
+static size_t read_varint(const uint8_t*& data)
+{
+    size_t value = 0;
+    for (uint8_t shift = 0; ; shift += 7) {
+        uint8_t byte = *data++;
+        value |= static_cast<size_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+}
+
+void encode_xor_delta(const uint8_t* a, const uint8_t* b, size_t size, vector<uint8_t>& delta)
+{
+    delta.clear();
+    size_t pos = 0;
+    while (pos < size) {
+        /* Most of a frame's state is unchanged, so skip equal words first */
+        size_t start = pos;
+        while (pos + 8 <= size) {
+            uint64_t word_a, word_b;
+            memcpy(&word_a, a + pos, 8);
+            memcpy(&word_b, b + pos, 8);
+            if (word_a != word_b) {
+                break;
+	    }
+            pos += 8;
+        }
+        while (pos < size && a[pos] == b[pos]) {
+            pos++;
+        }
+        append_varint(delta, pos - start);
+
+        /* Short equal runs inside a change are cheaper to keep as literals */
+        start = pos;
+        size_t equal_run = 0;
+        while (pos < size && equal_run < 4) {
+            equal_run = a[pos] == b[pos] ? equal_run + 1 : 0;
+            pos++;
+        }
+        if (equal_run == 4) {
+            pos -= 4;
+        }
+        append_varint(delta, pos - start);
+        for (size_t i = start; i < pos; i++) {
+            delta.push_back(a[i] ^ b[i]);
+        }
+    }
+}
+
+void apply_xor_delta(const vector<uint8_t>& delta, uint8_t* data)
+{
+    const uint8_t* pos = delta.data();
+    const uint8_t* end = pos + delta.size();
+    while (pos < end) {
+        data += read_varint(pos);
+        size_t changed = read_varint(pos);
+        for (size_t i = 0; i < changed; i++) {
+            data[i] ^= pos[i];
+        }
+        data += changed;
+        pos += changed;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* History of save states for rewinding. Only the newest state is kept whole;
+ * every older one is stored as the run-length encoded XOR of it and the state
+ * after it, so stepping back is one pass over mostly empty runs. Encoding
+ * happens on a background thread, and the oldest states are dropped to stay
+ * within the byte budget and frame limit. */
+class RewindBuffer {
+public:
+    RewindBuffer(std::size_t budget, std::size_t max_frames);
+    ~RewindBuffer();
+    RewindBuffer(const RewindBuffer& rewind) = delete;
+    RewindBuffer& operator=(const RewindBuffer& rewind) = delete;
+
+    /* Queues a state for the encoding thread. */
+    void push(std::vector<std::uint8_t> snapshot);
+    /* Takes the newest state out of the history, waiting for queued states
+     * to be encoded first. Returns false when the history is empty. */
+    bool pop(std::vector<std::uint8_t>& snapshot);
+
+    /* States still queued for encoding are not counted */
+    std::size_t frames();
+    /* Bytes held by the newest state and the deltas */
+    std::size_t bytes_used();
+private:
+    void run();
+
+    std::size_t budget;
+    std::size_t max_frames;
+
+    std::mutex history_mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::deque<std::vector<std::uint8_t>> pending;
+    bool encoding = false;
+    bool stopping = false;
+
+    /* Only the encoding thread changes head while encoding is set */
+    std::vector<std::uint8_t> head;
+    std::deque<std::vector<std::uint8_t>> deltas;
+    std::size_t delta_bytes = 0;
+    std::thread encoder;
+};
+
+/* XOR of two equally sized buffers as alternating runs: a varint count of
+ * equal bytes, then a varint count of differing bytes followed by their XOR. */
+void encode_xor_delta(const std::uint8_t* a, const std::uint8_t* b, std::size_t size,
+                      std::vector<std::uint8_t>& delta);
+/* XORs the delta back into data, turning one side of it into the other. */
+void apply_xor_delta(const std::vector<std::uint8_t>& delta, std::uint8_t* data);
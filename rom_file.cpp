@@ -0,0 +1,150 @@
+#include "rom_file.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using std::copy;
+using std::lock_guard;
+using std::make_tuple;
+using std::map;
+using std::max;
+using std::mutex;
+using std::shared_ptr;
+using std::size_t;
+using std::string;
+using std::tuple;
+using std::uint8_t;
+using std::uint16_t;
+using std::vector;
+using std::weak_ptr;
+
+const size_t HEADER_END = 0x150;
+
+/* Files are identified by inode, and by size and modification time so a
+ * rebuilt ROM is not served from a stale mapping. */
+typedef tuple<dev_t, ino_t, off_t, time_t> RomFileKey;
+
+static mutex registry_mutex;
+static map<RomFileKey, weak_ptr<const RomFile>> registry;
+
+static uint16_t header_rom_banks(uint8_t size_code, size_t file_size)
+{
+    switch (size_code) {
+    case 0x52: return 72;
+    case 0x53: return 80;
+    case 0x54: return 96;
+    }
+    if (size_code <= 0x8) {
+        return 2 << size_code;
+    }
+    /* Unknown size code, trust the file */
+    return max<size_t>((file_size + 0x3fff) / 0x4000, 2);
+}
+
+shared_ptr<const RomFile> RomFile::open(const string& filename)
+{
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    bool regular = S_ISREG(file_stat.st_mode);
+    RomFileKey key = make_tuple(file_stat.st_dev, file_stat.st_ino, file_stat.st_size, file_stat.st_mtime);
+    lock_guard<mutex> lock(registry_mutex);
+    if (regular) {
+        auto entry = registry.find(key);
+        shared_ptr<const RomFile> shared = entry != registry.end() ? entry->second.lock() : nullptr;
+        if (shared != nullptr) {
+            close(fd);
+            return shared;
+        }
+    }
+
+    shared_ptr<RomFile> rom_file(new RomFile());
+    bool loaded = regular ? rom_file->map_file(fd, file_stat.st_size) : rom_file->read_file(fd);
+    close(fd);
+    if (!loaded) {
+        return nullptr;
+    }
+
+    if (regular) {
+        for (auto it = registry.begin(); it != registry.end();) {
+            it = it->second.expired() ? registry.erase(it) : ++it;
+        }
+        registry[key] = rom_file;
+    }
+    return rom_file;
+}
+
+RomFile::~RomFile()
+{
+    if (this->mapped) {
+        munmap(const_cast<uint8_t*>(this->data), this->size);
+    } else {
+        delete[] this->data;
+    }
+}
+
+bool RomFile::map_file(int fd, size_t file_size)
+{
+    uint8_t header[HEADER_END];
+    if (file_size < HEADER_END || pread(fd, header, HEADER_END, 0) != static_cast<ssize_t>(HEADER_END)) {
+        return false;
+    }
+    this->rom_banks = header_rom_banks(header[0x148], file_size);
+    this->size = max<size_t>(file_size, this->rom_banks * 0x4000);
+
+    /* Reserve zeroed pages for the whole image and map the file over the start
+     * of it, so banks past the end of a short file read as 0 instead of faulting. */
+    void* image = mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (image == MAP_FAILED) {
+        return this->read_file(fd);
+    }
+    if (mmap(image, file_size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(image, this->size);
+        return this->read_file(fd);
+    }
+    this->data = static_cast<const uint8_t*>(image);
+    this->mapped = true;
+    return true;
+}
+
+bool RomFile::read_file(int fd)
+{
+    vector<uint8_t> contents;
+    uint8_t chunk[0x10000];
+    ssize_t bytes_read = 0;
+    lseek(fd, 0, SEEK_SET);
+    while ((bytes_read = read(fd, chunk, sizeof(chunk))) > 0) {
+        contents.insert(contents.end(), chunk, chunk + bytes_read);
+    }
+    if (bytes_read < 0 || contents.size() < HEADER_END) {
+        return false;
+    }
+
+    this->rom_banks = header_rom_banks(contents[0x148], contents.size());
+    this->size = max<size_t>(contents.size(), this->rom_banks * 0x4000);
+    uint8_t* buffer = new uint8_t[this->size]{0};
+    copy(contents.begin(), contents.end(), buffer);
+    this->data = buffer;
+    this->mapped = false;
+    return true;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/* A read-only cartridge ROM. Regular files are memory-mapped, and every State
+ * in the process that opens the same file shares one mapping. The image is
+ * zero-padded to the size declared in the header, so rom_banks full banks are
+ * always readable. */
+class RomFile {
+public:
+    static std::shared_ptr<const RomFile> open(const std::string& filename);
+    ~RomFile();
+    RomFile(const RomFile& rom_file) = delete;
+    RomFile& operator=(const RomFile& rom_file) = delete;
+
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+    std::uint16_t rom_banks = 0;
+private:
+    RomFile() = default;
+    bool map_file(int fd, std::size_t file_size);
+    bool read_file(int fd);
+
+    /* Set when data is a mapping rather than a buffer from new[] */
+    bool mapped = false;
+};
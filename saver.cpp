@@ -0,0 +1,158 @@
+#include "saver.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using std::cout;
+using std::lock_guard;
+using std::mutex;
+using std::rename;
+using std::size_t;
+using std::string;
+using std::thread;
+using std::uint8_t;
+using std::unique_lock;
+using std::vector;
+
+BatterySaver::BatterySaver(string filename) : filename(filename)
+{
+    this->writer = thread(&BatterySaver::run, this);
+}
+
+BatterySaver::~BatterySaver()
+{
+    {
+        lock_guard<mutex> lock(this->pending_mutex);
+        this->stopping = true;
+    }
+    this->wake.notify_one();
+    this->writer.join();
+}
+
+void BatterySaver::save(vector<uint8_t> data)
+{
+    {
+        lock_guard<mutex> lock(this->pending_mutex);
+        this->pending.swap(data);
+        this->has_pending = true;
+    }
+    this->wake.notify_one();
+}
+
+void BatterySaver::run()
+{
+    vector<uint8_t> data;
+    unique_lock<mutex> lock(this->pending_mutex);
+    while (true) {
+        this->wake.wait(lock, [this] {return this->has_pending || this->stopping;});
+        if (!this->has_pending) {
+            return;
+        }
+        data.swap(this->pending);
+        this->has_pending = false;
+
+        lock.unlock();
+        if (!this->write_file(data)) {
+            cout << "[WARNING]: Could not write save file " << this->filename << ".\n";
+        }
+        lock.lock();
+    }
+}
+
+bool BatterySaver::write_file(const vector<uint8_t>& data)
+{
+    string temp_filename = this->filename + ".tmp";
+    int fd = open(temp_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t result = write(fd, data.data() + written, data.size() - written);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        } else if (result < 0) {
+            close(fd);
+            return false;
+        }
+        written += result;
+    }
+    bool synced = fsync(fd) == 0;
+    if (close(fd) != 0 || !synced) {
+        return false;
+    }
+    return rename(temp_filename.c_str(), this->filename.c_str()) == 0;
+}
+
+MappedSaveFile::~MappedSaveFile()
+{
+    if (this->data != nullptr) {
+        msync(this->data, this->ram_size, MS_SYNC);
+        munmap(this->data, this->mapped_size);
+    }
+    if (this->fd >= 0) {
+        close(this->fd);
+    }
+}
+
+bool MappedSaveFile::open(const string& filename, uint32_t ram_size, uint32_t mapped_size, vector<uint8_t>& footer)
+{
+    this->fd = ::open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+    struct stat file_stat;
+    if (this->fd < 0 || fstat(this->fd, &file_stat) != 0) {
+        return false;
+    }
+    this->ram_size = ram_size;
+
+    if (file_stat.st_size > ram_size) {
+        footer.resize(file_stat.st_size - ram_size);
+        if (pread(this->fd, footer.data(), footer.size(), ram_size) != static_cast<ssize_t>(footer.size())) {
+            footer.clear();
+        }
+    } else if (file_stat.st_size < ram_size && ftruncate(this->fd, ram_size) != 0) {
+        return false;
+    }
+    if (ram_size == 0) {
+        return true;
+    }
+
+    /* Like ROMs, the file is mapped over zeroed memory so a small RAM still
+     * fills a whole bank without touching past the end of the file */
+    void* region = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        return false;
+    }
+    if (mmap(region, ram_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, this->fd, 0) == MAP_FAILED) {
+        munmap(region, mapped_size);
+        return false;
+    }
+    this->data = static_cast<uint8_t*>(region);
+    this->mapped_size = mapped_size;
+    return true;
+}
+
+void MappedSaveFile::sync(const vector<uint8_t>& footer, bool wait)
+{
+    if (this->data != nullptr) {
+        msync(this->data, this->ram_size, wait ? MS_SYNC : MS_ASYNC);
+    }
+    if (!footer.empty()) {
+        pwrite(this->fd, footer.data(), footer.size(), this->ram_size);
+    }
+    if (wait) {
+        fsync(this->fd);
+    }
+}
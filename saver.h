@@ -0,0 +1,60 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Writes battery saves on a background thread. Each save goes to a temporary
+ * file that is synced and renamed over the real one, so a crash leaves either
+ * the old or the new save. Snapshots handed in while a write is in progress
+ * replace each other, and only the newest one is written afterwards. */
+class BatterySaver {
+public:
+    explicit BatterySaver(std::string filename);
+    /* Finishes writing the newest snapshot before returning. */
+    ~BatterySaver();
+    BatterySaver(const BatterySaver& saver) = delete;
+    BatterySaver& operator=(const BatterySaver& saver) = delete;
+
+    /* Only takes a lock long enough to swap the snapshot in. */
+    void save(std::vector<std::uint8_t> data);
+private:
+    void run();
+    bool write_file(const std::vector<std::uint8_t>& data);
+
+    std::string filename;
+    std::mutex pending_mutex;
+    std::condition_variable wake;
+    std::vector<std::uint8_t> pending;
+    bool has_pending = false;
+    bool stopping = false;
+    std::thread writer;
+};
+
+/* Cartridge RAM backed by a shared mapping of the save file. The kernel writes
+ * dirty pages back on its own, and sync() bounds how stale the file can get.
+ * Anything past the RAM in the file, such as an RTC footer, is written with
+ * plain writes. */
+class MappedSaveFile {
+public:
+    MappedSaveFile() = default;
+    ~MappedSaveFile();
+    MappedSaveFile(const MappedSaveFile& save_file) = delete;
+    MappedSaveFile& operator=(const MappedSaveFile& save_file) = delete;
+
+    /* Maps ram_size bytes of the file into mapped_size bytes of zeroed memory,
+     * growing the file if it is short, and returns what follows the RAM in footer. */
+    bool open(const std::string& filename, std::uint32_t ram_size, std::uint32_t mapped_size,
+              std::vector<std::uint8_t>& footer);
+    void sync(const std::vector<std::uint8_t>& footer, bool wait);
+
+    std::uint8_t* data = nullptr;
+private:
+    int fd = -1;
+    std::uint32_t ram_size = 0;
+    std::size_t mapped_size = 0;
+};
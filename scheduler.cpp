@@ -0,0 +1,48 @@
+#include "scheduler.h"
+
+#include <algorithm>
+#include <cstdint>
+
+using std::fill_n;
+using std::min_element;
+using std::uint8_t;
+using std::uint64_t;
+
+Scheduler::Scheduler()
+{
+    fill_n(this->deadlines, EVENT_COUNT, NEVER);
+}
+
+void Scheduler::schedule(Event event, uint64_t when)
+{
+    uint64_t& deadline = this->deadlines[static_cast<uint8_t>(event)];
+    bool was_next = deadline == this->next;
+    deadline = when;
+    if (when < this->next) {
+        this->next = when;
+    } else if (was_next) {
+        this->find_next();
+    }
+}
+
+bool Scheduler::pop_due(Event& event, uint64_t& when)
+{
+    if (this->next > this->now) {
+        return false;
+    }
+    /* Ties go to the event declared first */
+    uint8_t index = 0;
+    while (this->deadlines[index] != this->next) {
+        index++;
+    }
+    event = static_cast<Event>(index);
+    when = this->next;
+    this->deadlines[index] = NEVER;
+    this->find_next();
+    return true;
+}
+
+void Scheduler::find_next()
+{
+    this->next = *min_element(this->deadlines, this->deadlines + EVENT_COUNT);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+/* Things that happen at a known machine cycle. The PPU and timer events are
+ * run by State::run_event(), the rest are the host's. */
+enum class Event : std::uint8_t {
+    LCD_HBLANK,
+    LINE_END,
+    TIMER_OVERFLOW,
+    AUDIO_UPDATE,
+    BATTERY_SAVE,
+    EVENT_COUNT
+};
+
+const std::uint8_t EVENT_COUNT = static_cast<std::uint8_t>(Event::EVENT_COUNT);
+const std::uint64_t NEVER = UINT64_MAX;
+
+/* Cycle-timestamped events, at most one pending per kind. With this few kinds
+ * a deadline per kind and a cached minimum beat a heap: scheduling is a store
+ * and a compare, and only taking an event rescans the deadlines. */
+class Scheduler {
+public:
+    Scheduler();
+
+    void schedule(Event event, std::uint64_t when);
+    void cancel(Event event) {this->schedule(event, NEVER);}
+    std::uint64_t deadline(Event event) const {return this->deadlines[static_cast<std::uint8_t>(event)];}
+    std::uint64_t next_deadline() const {return this->next;}
+    /* Takes the earliest event that is due by now and the cycle it was due at.
+     * Handlers reschedule from that cycle, so running late does not drift. */
+    bool pop_due(Event& event, std::uint64_t& when);
+
+    /* Machine cycles at the CPU clock, so they pass twice as fast in double
+     * speed mode. */
+    std::uint64_t now = 0;
+    std::uint64_t deadlines[EVENT_COUNT];
+private:
+    void find_next();
+
+    std::uint64_t next = NEVER;
+};
@@ -0,0 +1,89 @@
+#include "snapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using std::memcmp;
+using std::memcpy;
+using std::size_t;
+using std::uint8_t;
+using std::uint32_t;
+
+const char SNAPSHOT_MAGIC[4] = {'G', 'B', 'S', 'S'};
+const uint32_t SNAPSHOT_VERSION = 1;
+const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+const size_t SNAPSHOT_HEADER_SIZE = 12;
+const size_t CHUNK_HEADER_SIZE = 12;
+
+SnapshotWriter::SnapshotWriter(size_t reserve)
+{
+    this->data.reserve(reserve);
+    this->put_bytes(SNAPSHOT_MAGIC, 4);
+    this->put(SNAPSHOT_VERSION);
+    this->put(SNAPSHOT_BYTE_ORDER);
+}
+
+void SnapshotWriter::begin_chunk(const char* tag, uint32_t version)
+{
+    this->put_bytes(tag, 4);
+    this->put(version);
+    this->put(uint32_t(0));
+    this->chunk_start = this->data.size();
+}
+
+void SnapshotWriter::end_chunk()
+{
+    uint32_t size = this->data.size() - this->chunk_start;
+    memcpy(this->data.data() + this->chunk_start - 4, &size, 4);
+}
+
+SnapshotReader::SnapshotReader(const uint8_t* data, size_t size) : data(data)
+{
+    uint32_t version = 0;
+    uint32_t byte_order = 0;
+    if (size < SNAPSHOT_HEADER_SIZE || memcmp(data, SNAPSHOT_MAGIC, 4) != 0) {
+        return;
+    }
+    memcpy(&version, data + 4, 4);
+    memcpy(&byte_order, data + 8, 4);
+    if (version != SNAPSHOT_VERSION || byte_order != SNAPSHOT_BYTE_ORDER) {
+        return;
+    }
+
+    size_t pos = SNAPSHOT_HEADER_SIZE;
+    while (pos < size) {
+        Chunk chunk;
+        uint32_t chunk_size = 0;
+        if (size - pos < CHUNK_HEADER_SIZE) {
+            return;
+	}
+        memcpy(chunk.tag, data + pos, 4);
+        memcpy(&chunk.version, data + pos + 4, 4);
+        memcpy(&chunk_size, data + pos + 8, 4);
+        pos += CHUNK_HEADER_SIZE;
+        if (chunk_size > size - pos) {
+            return;
+	}
+        chunk.offset = pos;
+        chunk.size = chunk_size;
+        this->chunks.push_back(chunk);
+        pos += chunk_size;
+    }
+    this->is_valid = true;
+}
+
+uint32_t SnapshotReader::open_chunk(const char* tag)
+{
+    for (const Chunk& chunk : this->chunks) {
+        if (memcmp(chunk.tag, tag, 4) == 0) {
+            this->chunk_pos = chunk.offset;
+            this->chunk_end = chunk.offset + chunk.size;
+            return chunk.version;
+	}
+    }
+    this->chunk_pos = 0;
+    this->chunk_end = 0;
+    return 0;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/* Save state format. A 12-byte header (magic, format version, byte order mark)
+ * is followed by chunks, each a 4-character tag, a version and a payload size.
+ * Components version their chunks independently, and loaders skip chunks they
+ * do not know. Values are copied in host byte order, so states are only
+ * portable between machines with the same byte order, and loading a state
+ * from the other kind is refused. */
+class SnapshotWriter {
+public:
+    /* Whole machine states are a few hundred KiB, so reserve that by default */
+    explicit SnapshotWriter(std::size_t reserve = 0x60000);
+
+    void begin_chunk(const char* tag, std::uint32_t version);
+    void end_chunk();
+
+    template <typename T>
+    void put(const T& value)
+    {
+        this->put_bytes(&value, sizeof(T));
+    }
+    void put_bytes(const void* src, std::size_t size)
+    {
+        std::size_t offset = this->data.size();
+        this->data.resize(offset + size);
+        std::memcpy(this->data.data() + offset, src, size);
+    }
+
+    std::vector<std::uint8_t> data;
+private:
+    std::size_t chunk_start = 0;
+};
+
+class SnapshotReader {
+public:
+    /* Indexes the chunks. The data must outlive the reader. */
+    SnapshotReader(const std::uint8_t* data, std::size_t size);
+
+    /* False if the header is wrong or a chunk runs past the end */
+    bool valid() const {return this->is_valid;}
+    /* Moves to the chunk and returns its version, or 0 if there is none. */
+    std::uint32_t open_chunk(const char* tag);
+    /* Bytes left in the open chunk */
+    std::size_t remaining() const {return this->chunk_end - this->chunk_pos;}
+
+    /* Reads stop at the end of the open chunk and return false instead. */
+    template <typename T>
+    bool get(T& value)
+    {
+        return this->get_bytes(&value, sizeof(T));
+    }
+    bool get_bytes(void* dest, std::size_t size)
+    {
+        if (size > this->chunk_end - this->chunk_pos) {
+            return false;
+        }
+        std::memcpy(dest, this->data + this->chunk_pos, size);
+        this->chunk_pos += size;
+        return true;
+    }
+private:
+    struct Chunk {
+        char tag[4];
+        std::uint32_t version;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    const std::uint8_t* data;
+    std::vector<Chunk> chunks;
+    std::size_t chunk_pos = 0;
+    std::size_t chunk_end = 0;
+    bool is_valid = false;
+};
@@ -1,34 +1,69 @@
 #include "state.h"
+#include "block_cache.h"
 #include "instruction.h"
+#include "jit.h"
+#include "mapper.h"
+#include "rom_file.h"
+#include "snapshot.h"
+#include "tile_decode.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
-#include <ctime>
 #include <fstream>
 #include <iostream>
 #include <iterator>
 #include <string>
+#include <utility>
+#include <vector>
 
 using std::cout;
 using std::copy;
+using std::equal;
+using std::fill_n;
+using std::max;
+using std::min;
+using std::move;
 using std::hex;
 using std::ifstream;
 using std::istreambuf_iterator;
 using std::ofstream;
 using std::ostreambuf_iterator;
+using std::pair;
+using std::shared_ptr;
+using std::size_t;
 using std::string;
-using std::time;
-using std::time_t;
+using std::vector;
 using std::int8_t;
+using std::int32_t;
 using std::uint8_t;
 using std::uint16_t;
 using std::uint32_t;
+using std::uint64_t;
+
+const uint32_t PAGE_SIZE = 0x1000;
+const uint32_t MEMORY_PAGES = 0x10000 / PAGE_SIZE;
+const uint32_t WRAM_PAGES = 0x8000 / PAGE_SIZE;
+const uint32_t VRAM_PAGES = 0x2000 / PAGE_SIZE;
+const uint32_t LINE_CYCLES = 114;
+const uint32_t TRANSFER_START = 20;
+const uint32_t HBLANK_START = 63;
+const uint32_t FRAME_LINES = 154;
+const uint32_t VISIBLE_LINES = 144;
+/* TIMA periods in machine cycles, by the TAC clock select */
+const uint32_t TIMER_PERIODS[4] = {256, 4, 16, 64};
+const uint16_t ROM_HEADER_START = 0x134;
+const uint16_t ROM_HEADER_END = 0x150;
 
 State::State() : tile_data(new uint8_t[0x8000]{0}),
                  tile_data2(new uint8_t[0x8000]{0}),
                  memory(new uint8_t[0x10000]{0}), 
                  wram_banks(new uint8_t[0x8000]{0}),
-                 vram_banks(new uint8_t[0x2000]{0}) {}
+                 vram_banks(new uint8_t[0x2000]{0})
+{
+    fill_n(&this->tile_dirty[0][0], 2 * 0x180, 1);
+    this->update_pages();
+}
 
 State::~State()
 {
@@ -37,20 +72,31 @@ State::~State()
     delete this->tile_data2;
     delete this->wram_banks;
     delete this->vram_banks;
-    if (this->ram != nullptr) {delete this->ram;}
-    if (this->rom != nullptr) {delete this->rom;}
+    if (this->mapper != nullptr) {
+        this->mapper->sync_save_file(true);
+        delete this->mapper;
+    }
+    if (this->block_cache != nullptr) {delete this->block_cache;}
+    if (this->jit != nullptr) {delete this->jit;}
 }
 
 void State::dump_memory_to_file(string filename, string memory="work ram")
 {
-    uint8_t* mem = nullptr;
+    const uint8_t* mem = nullptr;
     uint32_t size = 0;
+    vector<uint8_t> save_data;
     if (memory == "work ram") {
-	size = 0x10000;
-	mem = this->memory;
-    } else if (memory == "ram" && ram != nullptr) {
-        size = this->ram_size;
-       	mem = this->ram;
+        /* I/O registers counted from the clock or kept outside memory are read */
+        save_data.assign(this->memory, this->memory + 0x10000);
+	for (uint32_t addr = 0xff00; addr <= 0xffff; addr++) {
+	    save_data[addr] = this->read_memory(addr);
+	}
+	size = save_data.size();
+	mem = save_data.data();
+    } else if (memory == "ram" && this->mapper != nullptr) {
+        save_data = this->mapper->save_data();
+        size = save_data.size();
+       	mem = save_data.data();
     } else {
 	return;
     }
@@ -59,13 +105,28 @@ void State::dump_memory_to_file(string filename, string memory="work ram")
          ostreambuf_iterator<char>(output_file));
 }
 
+bool State::map_save_file(string filename)
+{
+    if (this->mapper == nullptr || !this->mapper->map_save_file(filename)) {
+        return false;
+    }
+    this->mark_pages_dirty(this->mapper->ram, max<uint32_t>(this->mapper->ram_size, 0x2000));
+    this->update_pages();
+    return true;
+}
+
 bool State::load_file_to_memory(string filename, string memory="work ram")
 {
     uint8_t* mem = nullptr;
     if (memory == "work ram") {
         mem = this->memory;
-    } else if (memory == "ram" && ram != nullptr) {
-	mem = this->ram;
+    } else if (memory == "ram" && this->mapper != nullptr) {
+        ifstream save_file(filename, ifstream::binary);
+        vector<uint8_t> save_data((istreambuf_iterator<char>(save_file)), istreambuf_iterator<char>());
+	this->mapper->load_save_data(save_data);
+	this->mark_pages_dirty(this->mapper->ram, this->mapper->ram_size);
+	this->update_pages();
+	return !save_file.bad();
     } else {
 	return false;
     }
@@ -73,86 +134,448 @@ bool State::load_file_to_memory(string filename, string memory="work ram")
     copy(istreambuf_iterator<char>(memory_state),
          istreambuf_iterator<char>(),
          mem);
+    if (mem == this->memory) {
+        this->mark_tiles_dirty(this->memory + 0x8000, 0x1800);
+        this->mark_pages_dirty(this->memory, 0x10000);
+        this->interrupts.write_if(this->memory[0xff0f]);
+        this->interrupts.write_ie(this->memory[0xffff]);
+        this->schedule_lcd(this->scheduler.now);
+    }
 
     return static_cast<bool>(memory_state);
 }
 
-uint8_t State::read_vram_bank(uint16_t addr)
+void State::save_state(SnapshotWriter& writer)
 {
-    if (addr >= 0x2000) {
-        return 0xff;
+    /* Title, cartridge type and checksums identify the ROM */
+    writer.begin_chunk("ROM ", 1);
+    if (this->rom != nullptr) {
+        writer.put_bytes(this->rom + ROM_HEADER_START, ROM_HEADER_END - ROM_HEADER_START);
     }
-    return this->vram_banks[addr];
+    writer.end_chunk();
+    this->write_state(writer, true);
 }
 
-bool State::load_file_to_rom(string filename)
+void State::write_state(SnapshotWriter& writer, bool include_pages)
 {
-    ifstream rom_file(filename, ifstream::binary);
-    char tmp_buffer[0x150];
-    rom_file.read(tmp_buffer, 0x150);
-    rom_file.seekg(0);
+    writer.begin_chunk("CPU ", 2);
+    writer.put(this->registers);
+    writer.put(this->sp);
+    writer.put(this->pc);
+    writer.put(this->flags_pending);
+    writer.put(this->pending_flags_opcode);
+    writer.put(this->pending_flags_operands.first);
+    writer.put(this->pending_flags_operands.second);
+    writer.put(this->instructions_executed);
+    writer.put(this->stack_depth);
+    this->interrupts.save_state(writer);
+    writer.put(this->stop_mode);
+    writer.put(this->double_speed);
+    writer.put(this->prepare_double_speed);
+    writer.end_chunk();
 
-    this->cgb = ((uint8_t) tmp_buffer[0x143]) == 0x80 || ((uint8_t) tmp_buffer[0x143]) == 0xc0;
+    writer.begin_chunk("MEM ", 1);
+    if (include_pages) {
+        writer.put_bytes(this->memory, 0x10000);
+        writer.put_bytes(this->wram_banks, 0x8000);
+        writer.put_bytes(this->vram_banks, 0x2000);
+    }
+    writer.put(this->vram_bank);
+    writer.put(this->wram_bank);
+    writer.end_chunk();
+
+    writer.begin_chunk("DMA ", 1);
+    writer.put(this->prev_gdma_len);
+    writer.put(this->hdma_len);
+    this->save_pointer(writer, this->hdma_src);
+    this->save_pointer(writer, this->hdma_dest);
+    writer.end_chunk();
+
+    writer.begin_chunk("PPU ", 3);
+    writer.put(this->bg_palettes);
+    writer.put(this->obj_palettes);
+    writer.put(this->prev_oam_tile_ids);
+    writer.put(this->sorted_sprites);
+    writer.put(this->lcd_base);
+    writer.end_chunk();
+
+    writer.begin_chunk("TIME", 4);
+    writer.put(this->scheduler.now);
+    writer.put(EVENT_COUNT);
+    writer.put(this->scheduler.deadlines);
+    writer.put(this->div_base);
+    writer.put(this->tima_base);
+    writer.put(this->tima_value);
+    writer.end_chunk();
 
-    uint32_t rom_size = tmp_buffer[0x148];
-    switch (rom_size) {
-    case 0x52: rom_banks = 72; rom_size = 0x120000; break;
-    case 0x53: rom_banks = 80; rom_size = 0x140000; break;
-    case 0x54: rom_banks = 96; rom_size = 0x180000; break;
-    default: rom_banks = 2 << rom_size; rom_size = 0x8000 << rom_size; break;
+    if (this->mapper != nullptr) {
+        writer.begin_chunk("MBC ", 1);
+        this->mapper->save_state(writer, include_pages);
+        writer.end_chunk();
     }
-    this->rom = new uint8_t[rom_size]{0};
+}
 
-    ram_size = tmp_buffer[0x149];
-    switch (ram_size) {
-    case 0x00: ram_banks = 0; ram_size = 0; break;
-    case 0x01: ram_banks = 1; ram_size = 0x800; break;
-    case 0x02: ram_banks = 1; ram_size = 0x2000; break;
-    case 0x03: ram_banks = 4; ram_size = 0x8000; break;
-    case 0x04: ram_banks = 16; ram_size = 0x20000; break;
-    case 0x05: ram_banks = 8; ram_size = 0x10000; break;
+bool State::load_state(SnapshotReader& reader)
+{
+    uint8_t header[ROM_HEADER_END - ROM_HEADER_START]{0};
+    if (!reader.valid() || reader.open_chunk("ROM ") != 1
+        || reader.remaining() != (this->rom != nullptr ? sizeof(header) : 0)) {
+        return false;
+    }
+    reader.get(header);
+    if (this->rom != nullptr && !equal(header, header + sizeof(header), this->rom + ROM_HEADER_START)) {
+        return false;
     }
-    uint8_t mbc = tmp_buffer[0x147];
-    if (mbc == 5 || mbc == 6) {ram_size = 0x200;}
 
-    if (mbc >= 1 && mbc <= 3) {rom_bank = 1;}
-    if (mbc == 5 || mbc == 6) {rom_bank = 1;}
-    if (mbc >= 0xf && mbc <= 0x13) {rom_bank = 1;}
+    /* Chunks are read straight into the machine, so keep a copy to roll back to */
+    SnapshotWriter backup;
+    this->save_state(backup);
+    bool loaded = this->read_state(reader, true);
+    if (!loaded) {
+        SnapshotReader backup_reader(backup.data.data(), backup.data.size());
+        this->read_state(backup_reader, true);
+    }
 
-    if (ram_size != 0) {
-        this->ram = new uint8_t[ram_size]{0};
+    /* Decoded tiles and code compiled from RAM are stale */
+    fill_n(&this->tile_dirty[0][0], 2 * 0x180, 1);
+    this->invalidate_code(0x0000, 0x10000);
+    fill_n(this->page_dirty.begin(), this->page_dirty.size(), 1);
+    this->update_pages();
+    return loaded;
+}
+
+bool State::read_state(SnapshotReader& reader, bool include_pages)
+{
+    if (reader.open_chunk("CPU ") != 2 || !reader.get(this->registers) || !reader.get(this->sp)
+        || !reader.get(this->pc) || !reader.get(this->flags_pending) || !reader.get(this->pending_flags_opcode)
+        || !reader.get(this->pending_flags_operands.first) || !reader.get(this->pending_flags_operands.second)
+        || !reader.get(this->instructions_executed) || !reader.get(this->stack_depth)
+        || !this->interrupts.load_state(reader) || !reader.get(this->stop_mode)
+        || !reader.get(this->double_speed) || !reader.get(this->prepare_double_speed) || reader.remaining() != 0) {
+        return false;
     }
 
-    copy(istreambuf_iterator<char>(rom_file),
-         istreambuf_iterator<char>(),
-	 this->rom);
+    if (reader.open_chunk("MEM ") != 1
+        || (include_pages && (!reader.get_bytes(this->memory, 0x10000) || !reader.get_bytes(this->wram_banks, 0x8000)
+                              || !reader.get_bytes(this->vram_banks, 0x2000)))
+        || !reader.get(this->vram_bank) || !reader.get(this->wram_bank) || reader.remaining() != 0) {
+        return false;
+    }
 
-    return static_cast<bool>(rom_file);
+    const uint8_t* hdma_dest = nullptr;
+    if (reader.open_chunk("DMA ") != 1 || !reader.get(this->prev_gdma_len) || !reader.get(this->hdma_len)
+        || !this->load_pointer(reader, this->hdma_src) || !this->load_pointer(reader, hdma_dest)
+        || reader.remaining() != 0) {
+        return false;
+    }
+    bool dest_in_vram = (hdma_dest >= this->memory + 0x8000 && hdma_dest <= this->memory + 0xa000)
+                        || (hdma_dest >= this->vram_banks && hdma_dest <= this->vram_banks + 0x2000);
+    if (hdma_dest != nullptr && !dest_in_vram) {
+        return false;
+    }
+    this->hdma_dest = const_cast<uint8_t*>(hdma_dest);
+
+    if (reader.open_chunk("PPU ") != 3 || !reader.get(this->bg_palettes) || !reader.get(this->obj_palettes)
+        || !reader.get(this->prev_oam_tile_ids) || !reader.get(this->sorted_sprites) || !reader.get(this->lcd_base)
+        || reader.remaining() != 0) {
+        return false;
+    }
+
+    uint64_t now = 0;
+    uint8_t event_count = 0;
+    uint64_t deadlines[EVENT_COUNT];
+    if (reader.open_chunk("TIME") != 4 || !reader.get(now) || !reader.get(event_count) || event_count != EVENT_COUNT
+        || !reader.get(deadlines) || !reader.get(this->div_base) || !reader.get(this->tima_base)
+        || !reader.get(this->tima_value) || reader.remaining() != 0) {
+        return false;
+    }
+    this->scheduler.now = now;
+    for (uint8_t event = 0; event < EVENT_COUNT; event++) {
+        this->scheduler.schedule(static_cast<Event>(event), deadlines[event]);
+    }
+    /* HBlank events depend on whether this host draws lines */
+    this->schedule_lcd(now);
+
+    if (this->mapper != nullptr
+        && (reader.open_chunk("MBC ") != 1 || !this->mapper->load_state(reader, include_pages) || reader.remaining() != 0)) {
+        return false;
+    }
+    return true;
 }
 
-uint8_t State::read_memory(uint16_t addr)
+vector<pair<const uint8_t*, size_t>> State::pointer_regions() const
 {
+    vector<pair<const uint8_t*, size_t>> regions = {
+        {this->memory, 0x10000},
+        {this->wram_banks, 0x8000},
+        {this->vram_banks, 0x2000}
+    };
+    if (this->rom_file != nullptr) {
+        regions.emplace_back(this->rom, this->rom_file->size);
+    }
+    if (this->mapper != nullptr && this->mapper->ram != nullptr) {
+        regions.emplace_back(this->mapper->ram, this->mapper->ram_size);
+    }
+    return regions;
+}
 
-    uint8_t mbc = this->rom[0x147];
-    if (mbc >= 1 && mbc <= 3) {mbc = 1;}
-    if (mbc == 5 || mbc == 6) {mbc = 2;}
-    if (mbc >= 0xf && mbc <= 0x13) {mbc = 3;}
-    if (mbc >= 0x19 && mbc <= 0x1e) {mbc = 5;}
-
-    if (addr <= 0x7fff || (addr >= 0xa000 && addr <= 0xbfff)) {
-        if (addr <= 0x3fff) {
-            return this->rom[addr];
-        } else if (mbc == 0 && addr <= 0x7fff) {
-            return this->rom[addr];
-	} else if (mbc == 1) {
-            return this->read_mbc1(addr);
-	} else if (mbc == 2 && addr <= 0xa1ff) {
-            return this->read_mbc2(addr);
-	} else if (mbc == 3) {
-            return this->read_mbc3(addr);
-	} else if (mbc == 5) {
-            return this->read_mbc5(addr);
+void State::save_pointer(SnapshotWriter& writer, const uint8_t* pointer) const
+{
+    /* Index 0 is null. A pointer one past the end of a region is still in it. */
+    vector<pair<const uint8_t*, size_t>> regions = this->pointer_regions();
+    uint8_t index = 0;
+    uint32_t offset = 0;
+    for (uint8_t i = 0; pointer != nullptr && i < regions.size(); i++) {
+        if (pointer >= regions[i].first && pointer <= regions[i].first + regions[i].second) {
+            index = i + 1;
+            offset = pointer - regions[i].first;
+            break;
 	}
+    }
+    writer.put(index);
+    writer.put(offset);
+}
+
+bool State::load_pointer(SnapshotReader& reader, const uint8_t*& pointer) const
+{
+    vector<pair<const uint8_t*, size_t>> regions = this->pointer_regions();
+    uint8_t index = 0;
+    uint32_t offset = 0;
+    if (!reader.get(index) || !reader.get(offset) || index > regions.size()
+        || (index != 0 && offset > regions[index - 1].second)) {
+        return false;
+    }
+    pointer = index != 0 ? regions[index - 1].first + offset : nullptr;
+    return true;
+}
+
+StateSnapshot State::fork()
+{
+    uint32_t pages = this->page_count();
+    if (this->shared_pages.size() != pages) {
+        this->shared_pages.assign(pages, nullptr);
+        this->page_dirty.assign(pages, 1);
+    }
+
+    bool pages_copied = false;
+    for (uint32_t page = 0; page < pages; page++) {
+        if (this->page_dirty[page]) {
+            uint32_t size = 0;
+            const uint8_t* data = this->page_data(page, size);
+            uint8_t* page_copy = new uint8_t[size];
+            copy(data, data + size, page_copy);
+            this->shared_pages[page].reset(page_copy);
+            this->page_dirty[page] = 0;
+            pages_copied = true;
+        }
+    }
+    if (pages_copied) {
+        this->update_pages();
+    }
+
+    StateSnapshot snapshot;
+    snapshot.pages = this->shared_pages;
+    SnapshotWriter writer(0x400);
+    this->write_state(writer, false);
+    snapshot.registers = move(writer.data);
+    return snapshot;
+}
+
+bool State::restore(const StateSnapshot& snapshot)
+{
+    uint32_t pages = this->page_count();
+    if (snapshot.pages.size() != pages) {
+        return false;
+    }
+    if (this->shared_pages.size() != pages) {
+        this->shared_pages.assign(pages, nullptr);
+        this->page_dirty.assign(pages, 1);
+    }
+
+    for (uint32_t page = 0; page < pages; page++) {
+        if (!this->page_dirty[page] && this->shared_pages[page] == snapshot.pages[page]) {
+            continue;
+        }
+        uint32_t size = 0;
+        uint8_t* data = this->page_data(page, size);
+        copy(snapshot.pages[page].get(), snapshot.pages[page].get() + size, data);
+        this->shared_pages[page] = snapshot.pages[page];
+        this->page_dirty[page] = 0;
+
+        /* Decoded tiles and code compiled from the page are stale */
+        if (page < MEMORY_PAGES) {
+            this->invalidate_code(page * PAGE_SIZE, PAGE_SIZE);
+            if (page == 0x8 || page == 0x9) {
+                this->mark_tiles_dirty(data, PAGE_SIZE);
+            }
+        } else if (page < MEMORY_PAGES + WRAM_PAGES) {
+            this->invalidate_code(0xd000, PAGE_SIZE);
+        } else if (page < MEMORY_PAGES + WRAM_PAGES + VRAM_PAGES) {
+            this->invalidate_code(0x8000, 0x2000);
+            this->mark_tiles_dirty(data, PAGE_SIZE);
+        } else {
+            this->invalidate_code(0xa000, 0x2000);
+        }
+    }
+
+    SnapshotReader reader(snapshot.registers.data(), snapshot.registers.size());
+    bool restored = this->read_state(reader, false);
+    this->update_pages();
+    return restored;
+}
+
+uint32_t State::page_count() const
+{
+    uint32_t ram_pages = 0;
+    if (this->mapper != nullptr && this->mapper->ram != nullptr) {
+        ram_pages = (max<uint32_t>(this->mapper->ram_size, 0x2000) + PAGE_SIZE - 1) / PAGE_SIZE;
+    }
+    return MEMORY_PAGES + WRAM_PAGES + VRAM_PAGES + ram_pages;
+}
+
+uint8_t* State::page_data(uint32_t page, uint32_t& size) const
+{
+    size = PAGE_SIZE;
+    if (page < MEMORY_PAGES) {
+        return this->memory + page * PAGE_SIZE;
+    }
+    page -= MEMORY_PAGES;
+    if (page < WRAM_PAGES) {
+        return this->wram_banks + page * PAGE_SIZE;
+    }
+    page -= WRAM_PAGES;
+    if (page < VRAM_PAGES) {
+        return this->vram_banks + page * PAGE_SIZE;
+    }
+    page -= VRAM_PAGES;
+    /* Cartridge RAM is padded to a full bank, so RAM smaller than a page still fills one */
+    size = min(PAGE_SIZE, max<uint32_t>(this->mapper->ram_size, 0x2000) - page * PAGE_SIZE);
+    return this->mapper->ram + page * PAGE_SIZE;
+}
+
+int32_t State::page_index(const uint8_t* pointer) const
+{
+    if (pointer >= this->memory && pointer < this->memory + 0x10000) {
+        return (pointer - this->memory) / PAGE_SIZE;
+    } else if (pointer >= this->wram_banks && pointer < this->wram_banks + 0x8000) {
+        return MEMORY_PAGES + (pointer - this->wram_banks) / PAGE_SIZE;
+    } else if (pointer >= this->vram_banks && pointer < this->vram_banks + 0x2000) {
+        return MEMORY_PAGES + WRAM_PAGES + (pointer - this->vram_banks) / PAGE_SIZE;
+    }
+    const uint8_t* ram = this->mapper != nullptr ? this->mapper->ram : nullptr;
+    if (ram != nullptr && pointer >= ram && pointer < ram + max<uint32_t>(this->mapper->ram_size, 0x2000)) {
+        return MEMORY_PAGES + WRAM_PAGES + VRAM_PAGES + (pointer - ram) / PAGE_SIZE;
+    }
+    return -1;
+}
+
+void State::mark_pages_dirty(const uint8_t* pointer, uint32_t len)
+{
+    if (this->shared_pages.empty() || len == 0) {
+        return;
+    }
+    int32_t first = this->page_index(pointer);
+    int32_t last = this->page_index(pointer + len - 1);
+    if (first < 0 || last < 0) {
+        return;
+    }
+
+    bool newly_dirty = false;
+    for (int32_t page = first; page <= last; page++) {
+        newly_dirty |= !this->page_dirty[page];
+        this->page_dirty[page] = 1;
+    }
+    if (newly_dirty) {
+        this->update_pages();
+    }
+}
+
+void State::mark_address_dirty(uint16_t addr)
+{
+    if (this->shared_pages.empty()) {
+        return;
+    }
+
+    if (addr >= 0x8000 && addr <= 0x9fff) {
+        if (this->cgb && this->vram_bank == 1) {
+            this->mark_pages_dirty(this->vram_banks + addr - 0x8000, 1);
+        } else {
+            this->mark_pages_dirty(this->memory + addr, 1);
+        }
+    } else if (addr >= 0xa000 && addr <= 0xbfff && this->mapper != nullptr && this->mapper->ram != nullptr) {
+        /* MBC2 RAM is not mapped as a window */
+        if (this->mapper->ram_window != nullptr) {
+            this->mark_pages_dirty(this->mapper->ram_window + addr - 0xa000, 1);
+        } else {
+            this->mark_pages_dirty(this->mapper->ram, this->mapper->ram_size);
+        }
+    } else if (this->cgb && addr >= 0xd000 && addr <= 0xdfff) {
+        this->mark_pages_dirty(this->wram_banks + this->wram_bank * 0x1000 + addr - 0xd000, 1);
+    } else if ((addr >= 0xc000 && addr <= 0xdfff) || addr >= 0xfe00) {
+        this->mark_pages_dirty(this->memory + addr, 1);
+    }
+}
+
+void State::invalidate_code(uint32_t addr, uint32_t len)
+{
+    for (uint32_t line = addr >> 6; line < (addr + len) >> 6; line++) {
+        if (this->code_lines[line]) {
+            this->code_lines[line] = 0;
+            this->code_line_versions[line]++;
+        }
+    }
+}
+
+uint8_t State::read_vram_bank(uint16_t addr)
+{
+    if (addr >= 0x2000) {
+        return 0xff;
+    }
+    return this->vram_banks[addr];
+}
+
+bool State::load_file_to_rom(string filename)
+{
+    this->rom_file = RomFile::open(filename);
+    if (this->rom_file == nullptr) {
+        return false;
+    }
+    this->rom = this->rom_file->data;
+
+    this->cgb = this->rom[0x143] == 0x80 || this->rom[0x143] == 0xc0;
+    this->mapper = create_mapper(this->rom, this->rom_file->rom_banks);
+    /* Snapshots taken so far have no cartridge RAM */
+    this->shared_pages.clear();
+    this->page_dirty.clear();
+    this->update_pages();
+
+    return true;
+}
+
+uint8_t State::read_special(uint16_t addr)
+{
+    if (addr >= 0xff80 && addr <= 0xfffe) {
+        return this->memory[addr];
+    }
+
+    if (addr <= 0x7fff) {
+        return 0xff;
+    } else if (addr >= 0xa000 && addr <= 0xbfff) {
+        return this->mapper != nullptr ? this->mapper->read_ram(addr) : 0xff;
+    } else if (addr == 0xff04) {
+        return (this->scheduler.now - this->div_base) >> 6;
+    } else if (addr == 0xff05) {
+        return this->read_tima();
+    } else if (addr == 0xff0f) {
+        return this->interrupts.read_if();
+    } else if (addr == 0xffff) {
+        return this->interrupts.read_ie();
+    } else if (addr == 0xff00) {
+        return 0xc0 | (this->memory[0xff00] & 0x30) | this->joypad_lines();
+    } else if (addr == 0xff41) {
+        return this->read_stat();
+    } else if (addr == 0xff44) {
+        return this->read_ly();
     } else if (this->cgb && addr >= 0xd000 && addr <= 0xdfff) {
         return this->wram_banks[wram_bank * 0x1000 + addr - 0xd000];
     } else if (this->cgb && addr == 0xff4f) {
@@ -176,75 +599,6 @@ uint8_t State::read_memory(uint16_t addr)
     return 0;
 }
 
-uint8_t State::read_mbc1(uint16_t addr)
-{
-    if (addr >= 0x4000 && addr <= 0x7fff) {
-        uint8_t effective_rom_bank = this->ram_bank_mode ? (this->rom_bank & 0x1f) : this->rom_bank;
-        return this->rom[0x4000 * effective_rom_bank + addr - 0x4000];
-    } else {
-        if (!this->ram_enabled || this->ram == nullptr) {
-            return 0xff;
-	} else {
-            uint8_t effective_ram_bank = this->ram_bank_mode ? this->ram_bank : 0;
-            return this->ram[0x2000 * effective_ram_bank + addr - 0xa000];
-	}
-    }
-}
-
-uint8_t State::read_mbc2(uint16_t addr)
-{
-    if (addr >= 0x4000 && addr <= 0x7fff) {
-        return this->rom[0x4000 * this->rom_bank + addr - 0x4000];
-    } else {
-        if (!this->ram_enabled) {
-            return 0xff;
-	} else {
-            return this->ram[addr - 0xa000] & 0xf;
-	}
-    }
-}
-
-uint8_t State::read_mbc3(uint16_t addr)
-{
-    if (addr >= 0x4000 && addr <= 0x7fff) {
-        return this->rom[0x4000 * this->rom_bank + addr - 0x4000];
-    } else {
-        if (!this->ram_enabled) {
-            return 0xff;
-        } else if (this->ram_bank >= 0x8 && this->ram_bank <= 0xc) {
-            switch (this->ram_bank) {
-            case 0x8: return this->rtc_seconds;
-            case 0x9: return this->rtc_minutes;
-            case 0xa: return this->rtc_hours;
-            case 0xb: return this->rtc_days & 0xff;
-            case 0xc:
-                {
-                    uint8_t days_bit8 = (rtc_days & 0x100) >> 8;
-		    return this->rtc_flags | days_bit8;
-		}
-	    }
-	} else if (this->ram == nullptr) {
-            return 0xff;
-	} else if (this->ram_bank <= 3) {
-            return this->ram[0x2000 * this->ram_bank + addr - 0xa000];
-	}
-    }
-    return 0xff;
-}
-
-uint8_t State::read_mbc5(uint16_t addr)
-{
-    if (addr >= 0x4000 && addr <= 0x7fff) {
-        return this->rom[0x4000 * this->rom_bank + addr - 0x4000];
-    } else {
-        if (!this->ram_enabled || this->ram == nullptr) {
-            return 0xff;
-	} else {
-            return this->ram[0x2000 * this->ram_bank + addr - 0xa000];
-	}
-    }
-}
-
 void State::run_hdma()
 {
     if (this->hdma_len <= 0) {
@@ -253,7 +607,10 @@ void State::run_hdma()
     }
 
     uint32_t len = (this->hdma_len < 0x10) ? this->hdma_len : 0x10;
+    this->mark_pages_dirty(this->hdma_dest, len);
+    this->mark_pages_dirty(this->memory + 0xff51, 5);
     copy(this->hdma_src, this->hdma_src + len, this->hdma_dest);
+    this->mark_tiles_dirty(this->hdma_dest, len);
     this->hdma_len -= len;
     this->hdma_src += len;
     this->hdma_dest += len;
@@ -269,36 +626,59 @@ void State::run_hdma()
     this->memory[0xff55] = (this->hdma_len <= 0) ? 0xff : (this->hdma_len / 0x10 - 1);
 }
 
-void State::write_memory(uint16_t addr, uint8_t value)
+void State::write_special(uint16_t addr, uint8_t value)
 {
-    uint8_t mbc = this->rom[0x147];
-    if (mbc >= 1 && mbc <= 3) {mbc = 1;}
-    if (mbc == 5 || mbc == 6) {mbc = 2;}
-    if (mbc >= 0xf && mbc <= 0x13) {mbc = 3;}
-    if (mbc >= 0x19 && mbc <= 0x1e) {mbc = 5;}
+    if (this->write_log != nullptr) {
+        this->write_log->emplace_back(addr, this->read_memory(addr));
+    }
+    if (this->code_lines[addr >> 6]) {
+        this->code_lines[addr >> 6] = 0;
+        this->code_line_versions[addr >> 6]++;
+    }
 
-    uint16_t prev_rom_bank = rom_bank;
-    uint16_t prev_ram_bank = ram_bank;
+    if (addr >= 0x8000 && addr <= 0x97ff) {
+        this->tile_dirty[this->cgb && this->vram_bank == 1][(addr - 0x8000) >> 4] = 1;
+    }
+    this->mark_address_dirty(addr);
 
-    if ((addr <= 0x7fff || (addr >= 0xa000 && addr <= 0xbfff)) && mbc == 1) {
-        this->write_mbc1(addr, value);
-    } else if ((addr <= 0x3fff || (addr >= 0xa000 && addr <= 0xa1ff)) && mbc == 2) {
-        this->write_mbc2(addr, value);
-    } else if ((addr <= 0x7fff || (addr >= 0xa000 && addr <= 0xbfff)) && mbc == 3) {
-        this->write_mbc3(addr, value);
-    } else if ((addr <= 0x5fff || (addr >= 0xa000 && addr <= 0xbfff)) && mbc == 5) {
-        this->write_mbc5(addr, value);
-    } else if (this->cgb && this->vram_bank == 1 && addr >= 0x8000 && addr <= 0x9fff) {
+    uint8_t* page = this->write_pages[addr >> 8];
+    if (page != nullptr) {
+        page[addr & 0xff] = value;
+        return;
+    } else if (addr >= 0xff80 && addr <= 0xfffe) {
+        this->memory[addr] = value;
+        return;
+    }
+
+    if (addr <= 0x7fff || (addr >= 0xa000 && addr <= 0xbfff)) {
+        if (this->mapper == nullptr) {
+            return;
+	}
+        uint16_t prev_rom_bank_low = this->mapper->rom_bank_low;
+        uint16_t prev_rom_bank_high = this->mapper->rom_bank_high;
+        uint8_t* prev_ram_window = this->mapper->ram_window;
+        if (this->mapper->write(addr, value)) {
+            this->save_pending = true;
+	}
+	if (this->mapper->rom_bank_low != prev_rom_bank_low || this->mapper->rom_bank_high != prev_rom_bank_high
+	    || this->mapper->ram_window != prev_ram_window) {
+            this->update_pages();
+	}
+	return;
+    }
+
+    uint8_t prev_vram_bank = vram_bank;
+    uint8_t prev_wram_bank = wram_bank;
+
+    if (this->cgb && this->vram_bank == 1 && addr >= 0x8000 && addr <= 0x9fff) {
         this->vram_banks[addr - 0x8000] = value;
     } else if (this->cgb && addr >= 0xd000 && addr <= 0xdfff) {
         this->wram_banks[wram_bank * 0x1000 + addr - 0xd000] = value;
     } else if (addr == 0xff46 && value <= 0xf1) {
-        uint8_t* src = this->memory + (value << 8);
-        if (this->cgb && this->vram_bank == 1 && value >= 0x80 && value <= 0x9f) {
-	    src = this->vram_banks + (value << 8) - 0x8000;
-	} else if (this->ram_enabled && this->ram != nullptr && value >= 0xa0 && value <= 0xbf) {
-	    uint8_t effective_ram_bank = this->ram_bank_mode ? this->ram_bank : 0;
-	    src = this->ram + 0x2000 * effective_ram_bank + (value << 8) - 0xa000;
+        /* The source never crosses a page */
+        const uint8_t* src = this->read_pages[value];
+        if (src == nullptr) {
+	    src = this->memory + (value << 8);
 	}
 	copy(src, src + 0xa0, this->memory + 0xfe00);
     } else if (this->cgb && addr == 0xff55 && (value & 0x7f) != 0) {
@@ -311,27 +691,27 @@ void State::write_memory(uint16_t addr, uint8_t value)
         uint16_t dest = (this->memory[0xff53] << 8 | this->memory[0xff54]) & 0x1ff0;
 	uint16_t len = ((value & 0x7f) + 1) * 0x10;
 	uint8_t* vram_ptr = (this->vram_bank == 1) ? this->vram_banks : (this->memory + 0x8000);
-	uint8_t* mem_ptr = nullptr;
+	const uint8_t* mem_ptr = nullptr;
 
         if (dest + len >= 0x2000) {
 	    len = 0x2000 - dest;
 	}
 
-	if (src <= 0x3ff0) {
+	if (this->mapper != nullptr && src <= 0x3ff0) {
 	    if (src + len >= 0x4000) {
                 len = 0x4000 - src;
 	    }
-	    mem_ptr = this->memory + src;
-	} else if (src <= 0x7ff0) {
+	    mem_ptr = this->rom + 0x4000 * this->mapper->rom_bank_low + src;
+	} else if (this->mapper != nullptr && src <= 0x7ff0) {
 	    if (src + len >= 0x8000) {
                 len = 0x8000 - src;
 	    }
-	    mem_ptr = this->rom + 0x4000 * this->rom_bank + src - 0x4000;
-	} else if (this-ram_enabled && this->ram != nullptr && src >= 0xa000 && src <= 0xbff0) {
+	    mem_ptr = this->rom + 0x4000 * this->mapper->rom_bank_high + src - 0x4000;
+	} else if (this->mapper != nullptr && this->mapper->ram_window != nullptr && src >= 0xa000 && src <= 0xbff0) {
 	    if (src + len >= 0xc000) {
                 len = 0xc000 - src;
 	    }
-	    mem_ptr = this->ram + 0x2000 * this->ram_bank + src - 0xa000;
+	    mem_ptr = this->mapper->ram_window + src - 0xa000;
 	} else if (src >= 0xc000 && src <= 0xcff0) {
 	    if (src + len >= 0xd000) {
                 len = 0xd000 - src;
@@ -349,9 +729,12 @@ void State::write_memory(uint16_t addr, uint8_t value)
 	    this->hdma_src = mem_ptr;
 	    this->hdma_dest = vram_ptr + dest;
 	    this->memory[0xff55] = len / 0x10 - 1;
+	    this->schedule_lcd(this->scheduler.now);
 	} else if (!(value & 0x80)) {
 	    if (mem_ptr != nullptr) {
+	        this->mark_pages_dirty(vram_ptr + dest, len);
 	        copy(mem_ptr, mem_ptr + len, vram_ptr + dest);
+		this->mark_tiles_dirty(vram_ptr + dest, len);
 	    }
 	    this->memory[0xff51] = ((src + len) & 0xfff0) >> 8;
 	    this->memory[0xff52] = ((src + len) & 0xfff0) && 0xff;
@@ -360,6 +743,41 @@ void State::write_memory(uint16_t addr, uint8_t value)
 	    this->memory[0xff55] = 0xff;
 	    this->prev_gdma_len = len / 0x10 - 1;
 	}
+    } else if (addr == 0xff00) {
+        /* Selecting a group with a button held is an edge too */
+        uint8_t lines = this->joypad_lines();
+        this->memory[0xff00] = value & 0x30;
+        if (lines & ~this->joypad_lines()) {
+	    this->interrupts.request(0x10);
+	}
+    } else if (addr == 0xff0f) {
+        this->interrupts.write_if(value);
+    } else if (addr == 0xffff) {
+        this->interrupts.write_ie(value);
+    } else if (addr == 0xff04) {
+        this->sync_timer();
+        this->div_base = this->scheduler.now;
+        this->schedule_timer();
+    } else if (addr == 0xff05) {
+        this->tima_value = value;
+        this->tima_base = this->scheduler.now;
+        this->schedule_timer();
+    } else if (addr == 0xff07) {
+        this->sync_timer();
+        this->memory[0xff07] = value;
+        this->schedule_timer();
+    } else if (addr == 0xff40) {
+        /* Line 0 starts when the LCD is switched on */
+        if ((value & 0x80) && !(this->memory[0xff40] & 0x80)) {
+	    this->lcd_base = this->scheduler.now;
+	}
+        this->memory[0xff40] = value;
+	this->schedule_lcd(this->scheduler.now);
+    } else if (addr == 0xff41 || addr == 0xff45) {
+        this->memory[addr] = value;
+	this->schedule_lcd(this->scheduler.now);
+    } else if (addr == 0xff44) {
+        /* LY is read only */
     } else if (this->cgb && addr == 0xff4d) {
         this->prepare_double_speed = value & 0x1;
     } else if (this->cgb && addr == 0xff4f) {
@@ -386,143 +804,295 @@ void State::write_memory(uint16_t addr, uint8_t value)
         this->memory[addr] = value;
     }
 
-    if (rom_bank >= rom_banks) {
-        rom_bank = prev_rom_bank;
-    }
-    if (ram_bank >= ram_banks) {
-        ram_bank = prev_ram_bank;
+    if (vram_bank != prev_vram_bank || wram_bank != prev_wram_bank) {
+        this->update_pages();
     }
 }
 
-void State::write_mbc1(uint16_t addr, uint8_t value)
+void State::run_event(Event event, uint64_t when)
 {
-    if (addr <= 0x1fff) {
-        this->ram_enabled = (value & 0xf) == 0xa;
-    } else if (addr >= 0x2000 && addr <= 0x3fff) {
-        value &= 0x1f;
-	if ((value & 0x1f) == 0) {value |= 1;}
-	this->rom_bank &= ~0x1f;
-	this->rom_bank |= value;
-    } else if (addr >= 0x4000 && addr <= 0x5fff) {
-        if (this->ram_bank_mode) {
-            this->ram_bank = value & 0x3;
-	} else {
-            value = (value & 0x3) << 5;
-	    this->rom_bank &= ~0x60;
-	    this->rom_bank |= value;
+    switch (event) {
+    case Event::LCD_HBLANK:
+	if (!(this->memory[0xff55] & 0x80)) {
+	    this->run_hdma();
+	}
+	this->schedule_lcd(when);
+	break;
+    case Event::LINE_END: {
+	uint8_t ly = this->lcd_position(when) / LINE_CYCLES;
+	uint8_t lcd_stat = this->memory[0xff41];
+	bool lyc = ly == this->memory[0xff45];
+	if ((lcd_stat & 0x8) || (lcd_stat & 0x20) || ((lcd_stat & 0x40) && lyc)) {
+	    this->interrupts.request(0x2);
 	}
-    } else if (addr >= 0x6000 && addr <= 0x7fff) {
-        this->ram_bank_mode = (value & 0x1) != 0;
-    } else if (this->ram_enabled && this->ram != nullptr && addr >= 0xa000 && addr <= 0xbfff) {
-        uint8_t effective_ram_bank = this->ram_bank_mode ? this->ram_bank : 0;
-        this->ram[0x2000 * effective_ram_bank + addr - 0xa000] = value;
-	save_pending = true;
-    }
-}
-
-void State::write_mbc2(uint16_t addr, uint8_t value)
-{
-    if (addr <= 0x1fff && !(addr & 0x100)) {
-        this->ram_enabled = value == 0xa;
-    } else if (addr >= 0x2000 && addr <= 0x3fff && (addr & 0x100)) {
-        value &= 0xf;
-	if ((value & 0xf) == 0) {value |= 1;}
-	this->rom_bank = value;
-    } else if (this->ram_enabled && addr >= 0xa000 && addr <= 0xa1ff) {
-        this->ram[addr - 0xa000] = value & 0xf;
-	save_pending = true;
-    }
-}
-
-void State::write_mbc3(uint16_t addr, uint8_t value)
-{
-    if (addr <= 0x1fff) {
-        this->ram_enabled = value == 0xa;
-    } else if (addr >= 0x2000 && addr <= 0x3fff) {
-	this->rom_bank = value & 0x7f;
-    } else if (addr >= 0x4000 && addr <= 0x5fff) {
-        this->ram_bank = value;
-    } else if (addr >= 0x6000 && addr <= 0x7fff) {
-        if (this->prev_rtc_latch == 0 && value == 1) {
-            time_t now = time(0);
-	    this->rtc_seconds = now % 60;
-	    this->rtc_minutes = (now / 60) % 60;
-	    this->rtc_hours = (now / 3600) % 24;
-	    uint16_t prev_rtc_days = this->rtc_days;
-	    this->rtc_days = (now / 3600 / 24) % 512;
-	    if (rtc_days < prev_rtc_days) {
-                this->rtc_flags |= 0x80;
+	if (ly == VISIBLE_LINES) {
+	    this->interrupts.request(0x1);
+	    if (lcd_stat & 0x10) {
+	        this->interrupts.request(0x2);
 	    }
 	}
-	this->prev_rtc_latch = value;
-    } else if (this->ram_enabled && addr >= 0xa000 && addr <= 0xbfff) {
-        if (this->ram_bank >= 0x8 && this->ram_bank <= 0xc) {
-            switch (this->ram_bank) {
-            case 0x8: this->rtc_seconds = value; break;
-            case 0x9: this->rtc_minutes = value; break;
-            case 0xa: this->rtc_hours = value; break;
-            case 0xb: this->rtc_days = (this->rtc_days & 0xff00) | value; break;
-            case 0xc:
-                {
-		    this->rtc_flags = value;
-		    this->rtc_days &= 0x00ff;
-		    this->rtc_days |= (value & 0x1) << 8;
+	this->schedule_lcd(when);
+	break;
+    }
+    case Event::TIMER_OVERFLOW:
+        this->tima_value = this->memory[0xff06];
+	this->tima_base = max(when, this->div_base);
+	this->interrupts.request(0x4);
+	this->schedule_timer();
+	break;
+    default:
+        break;
+    }
+}
+
+void State::switch_speed()
+{
+    uint32_t position = this->lcd_position(this->scheduler.now);
+    uint8_t ly = this->read_ly();
+    this->double_speed = !this->double_speed;
+    this->prepare_double_speed = false;
+
+    uint64_t now = this->scheduler.now;
+    for (uint8_t index = 0; index < EVENT_COUNT; index++) {
+        Event event = static_cast<Event>(index);
+        uint64_t deadline = this->scheduler.deadline(event);
+        if (event != Event::TIMER_OVERFLOW && deadline != NEVER && deadline > now) {
+            uint64_t remaining = this->double_speed ? (deadline - now) * 2 : (deadline - now) / 2;
+            this->scheduler.schedule(event, now + remaining);
+	}
+    }
+    /* Keep the frame position. Wrapping below zero still gives the right differences. */
+    uint8_t speed = this->double_speed ? 2 : 1;
+    this->lcd_base = now - position * speed;
+    this->schedule_lcd(now);
+
+    /* LY must not jump, and line events must still fall on line starts */
+    uint64_t line_end = this->scheduler.deadline(Event::LINE_END);
+    if (this->read_ly() != ly || (line_end != NEVER && (line_end - this->lcd_base) % (LINE_CYCLES * speed) != 0)) {
+        cout << "[WARNING]: LCD timing lost across a speed switch at " << hex << this->pc << ".\n";
+    }
+}
+
+void State::set_buttons(uint8_t buttons)
+{
+    uint8_t lines = this->joypad_lines();
+    this->buttons = buttons;
+    if (lines & ~this->joypad_lines()) {
+        this->interrupts.request(0x10);
+    }
+}
+
+uint8_t State::joypad_lines() const
+{
+    /* A low select bit connects its group, and both groups can be selected */
+    uint8_t select = this->memory[0xff00];
+    uint8_t lines = 0xf;
+    if (!(select & 0x10)) {
+        lines &= this->buttons;
+    }
+    if (!(select & 0x20)) {
+        lines &= this->buttons >> 4;
+    }
+    return lines & 0xf;
+}
+
+uint64_t State::next_change(uint16_t addr, uint64_t since) const
+{
+    /* DIV, TIMA, LY and STAT are counted from the clock, everything else
+     * changes in events */
+    uint8_t speed = this->double_speed ? 2 : 1;
+    if ((addr == 0xff41 || addr == 0xff44) && (this->memory[0xff40] & 0x80)) {
+        uint64_t line_start = since - (since - this->lcd_base) % (LINE_CYCLES * speed);
+        if (addr == 0xff41) {
+	    for (uint32_t mode_start : {TRANSFER_START, HBLANK_START}) {
+	        if (line_start + mode_start * speed > since) {
+		    return line_start + mode_start * speed;
 		}
-                break;  
 	    }
-	} else if (this->ram != nullptr && this->ram_bank <= 3) {
-            this->ram[0x2000 * this->ram_bank + addr - 0xa000] = value;
-	    save_pending = true;
 	}
+        return line_start + LINE_CYCLES * speed;
+    } else if (addr == 0xff04) {
+        return since + 64 - (since - this->div_base) % 64;
+    } else if (addr == 0xff05 && (this->memory[0xff07] & 0x4)) {
+        uint32_t period = TIMER_PERIODS[this->memory[0xff07] & 0x3];
+        return since + period - (since - this->div_base) % period;
     }
+    return NEVER;
 }
 
-void State::write_mbc5(uint16_t addr, uint8_t value)
+uint32_t State::lcd_position(uint64_t when) const
 {
-    if (addr <= 0x1fff) {
-        this->ram_enabled = value == 0xa;
-    } else if (addr >= 0x2000 && addr <= 0x2fff) {
-        this->rom_bank &= 0xff00;
-	this->rom_bank |= value;
-    } else if (addr >= 0x3000 && addr <= 0x3fff) {
-        this->rom_bank &= 0x00ff;
-	this->rom_bank |= (value & 0x1) << 8;
-    } else if (addr >= 0x4000 && addr <= 0x5fff) {
-        this->ram_bank = value & 0x0f;
-    } else if (this->ram_enabled && this->ram != nullptr && addr >= 0xa000 && addr <= 0xbfff) {
-        this->ram[0x2000 * this->ram_bank + addr - 0xa000] = value;
-	save_pending = true;
+    uint8_t speed = this->double_speed ? 2 : 1;
+    return (when - this->lcd_base) / speed % (LINE_CYCLES * FRAME_LINES);
+}
+
+uint8_t State::read_ly() const
+{
+    if (!(this->memory[0xff40] & 0x80)) {
+        return 0;
     }
+    return this->lcd_position(this->scheduler.now) / LINE_CYCLES;
 }
 
-void State::update_tile_data()
+uint8_t State::read_stat() const
 {
-    for (uint32_t i = 0; i < 0x1000; i++) {
-        uint8_t data1 = this->memory[0x8000 + i * 2];
-        uint8_t data2 = this->memory[0x8000 + i * 2 + 1];
+    uint8_t ly = this->read_ly();
+    uint8_t lcd_stat = (this->memory[0xff41] & ~0x7) | (ly == this->memory[0xff45] ? 0x4 : 0);
+    if (!(this->memory[0xff40] & 0x80)) {
+        return lcd_stat;
+    }
 
-	for (int8_t n = 7; n >= 0; n--) {
-	    uint8_t pixel = 0;
-            pixel |= (data1 & (1 << n)) >> n << 1;
-            pixel |= (data2 & (1 << n)) >> n;
-	    this->tile_data[i * 8 + (7 - n)] = pixel;
-	}
+    uint32_t dot = this->lcd_position(this->scheduler.now) % LINE_CYCLES;
+    if (ly >= VISIBLE_LINES) {
+        return lcd_stat | 0x1;
+    } else if (dot < TRANSFER_START) {
+        return lcd_stat | 0x2;
+    } else if (dot < HBLANK_START) {
+        return lcd_stat | 0x3;
     }
+    return lcd_stat;
+}
 
-    if (!this->cgb) {
-        return;
+void State::schedule_lcd(uint64_t from)
+{
+    if (!(this->memory[0xff40] & 0x80)) {
+        this->scheduler.cancel(Event::LINE_END);
+        this->scheduler.cancel(Event::LCD_HBLANK);
+	return;
     }
 
-    for (uint32_t i = 0; i < 0x1000; i++) {
-        uint8_t data1 = this->vram_banks[i * 2];
-        uint8_t data2 = this->vram_banks[i * 2 + 1];
+    /* Lines are counted from lcd_base, so line % FRAME_LINES is LY */
+    uint8_t speed = this->double_speed ? 2 : 1;
+    uint64_t line = (from - this->lcd_base) / speed / LINE_CYCLES;
+    uint32_t dot = (from - this->lcd_base) / speed % LINE_CYCLES;
 
-	for (int8_t n = 7; n >= 0; n--) {
-	    uint8_t pixel = 0;
-            pixel |= (data1 & (1 << n)) >> n << 1;
-            pixel |= (data2 & (1 << n)) >> n;
-	    this->tile_data2[i * 8 + (7 - n)] = pixel;
+    /* Only line starts that raise an interrupt need an event: VBlank, the LYC
+     * line for the coincidence interrupt, or every line for the mode 0 and
+     * mode 2 interrupts. */
+    uint8_t lcd_stat = this->memory[0xff41];
+    uint8_t lyc = this->memory[0xff45];
+    uint64_t next_line = line + 1;
+    if (!(lcd_stat & 0x28)) {
+        uint32_t ly = next_line % FRAME_LINES;
+        uint32_t lines = (VISIBLE_LINES + FRAME_LINES - ly) % FRAME_LINES;
+        if ((lcd_stat & 0x40) && lyc < FRAME_LINES) {
+	    lines = min(lines, (lyc + FRAME_LINES - ly) % FRAME_LINES);
 	}
+	next_line += lines;
+    }
+    this->scheduler.schedule(Event::LINE_END, this->lcd_base + next_line * LINE_CYCLES * speed);
+
+    /* HBlank events draw lines for the host and run HDMA */
+    if (!this->draw_lines && (this->memory[0xff55] & 0x80)) {
+        this->scheduler.cancel(Event::LCD_HBLANK);
+	return;
+    }
+    uint64_t hblank_line = dot < HBLANK_START ? line : line + 1;
+    if (hblank_line % FRAME_LINES >= VISIBLE_LINES) {
+        hblank_line += FRAME_LINES - hblank_line % FRAME_LINES;
+    }
+    this->scheduler.schedule(Event::LCD_HBLANK,
+                             this->lcd_base + (hblank_line * LINE_CYCLES + HBLANK_START) * speed);
+}
+
+uint8_t State::read_tima() const
+{
+    uint8_t tac = this->memory[0xff07];
+    if (!(tac & 0x4)) {
+        return this->tima_value;
+    }
+    uint32_t period = TIMER_PERIODS[tac & 0x3];
+    uint64_t edges = (this->scheduler.now - this->div_base) / period - (this->tima_base - this->div_base) / period;
+    return this->tima_value + edges;
+}
+
+void State::sync_timer()
+{
+    this->tima_value = this->read_tima();
+    this->tima_base = this->scheduler.now;
+}
+
+void State::schedule_timer()
+{
+    uint8_t tac = this->memory[0xff07];
+    if (!(tac & 0x4)) {
+        this->scheduler.cancel(Event::TIMER_OVERFLOW);
+	return;
+    }
+    /* TIMA overflows on the edge that takes it past 0xff */
+    uint32_t period = TIMER_PERIODS[tac & 0x3];
+    uint64_t edges = (this->tima_base - this->div_base) / period + (0x100 - this->tima_value);
+    this->scheduler.schedule(Event::TIMER_OVERFLOW, this->div_base + edges * period);
+}
+
+void State::update_pages()
+{
+    for (uint32_t page = 0; page < 0x100; page++) {
+        uint16_t addr = page << 8;
+        const uint8_t* read_page = nullptr;
+        uint8_t* write_page = nullptr;
+
+        if (addr <= 0x7fff && this->mapper == nullptr) {
+            read_page = nullptr;
+        } else if (addr <= 0x3fff) {
+            read_page = this->rom + 0x4000 * this->mapper->rom_bank_low + addr;
+        } else if (addr <= 0x7fff) {
+            read_page = this->rom + 0x4000 * this->mapper->rom_bank_high + addr - 0x4000;
+        } else if (addr <= 0x97ff) {
+            /* Tile data writes go through write_special() to mark the tile dirty */
+            if (this->cgb && this->vram_bank == 1) {
+                read_page = this->vram_banks + addr - 0x8000;
+            } else {
+                read_page = this->memory + addr;
+            }
+        } else if (addr <= 0x9fff) {
+            if (this->cgb && this->vram_bank == 1) {
+                write_page = this->vram_banks + addr - 0x8000;
+            } else {
+                write_page = this->memory + addr;
+            }
+            read_page = write_page;
+        } else if (addr <= 0xbfff) {
+            /* Writes stay in write_special() to mark the save file as dirty */
+            if (this->mapper != nullptr && this->mapper->ram_window != nullptr) {
+                read_page = this->mapper->ram_window + addr - 0xa000;
+            }
+        } else if (addr <= 0xcfff) {
+            write_page = this->memory + addr;
+            read_page = write_page;
+        } else if (addr <= 0xdfff) {
+            if (this->cgb) {
+                write_page = this->wram_banks + this->wram_bank * 0x1000 + addr - 0xd000;
+            } else {
+                write_page = this->memory + addr;
+            }
+            read_page = write_page;
+        }
+
+        /* Pages shared with a snapshot are written through write_special() until marked dirty */
+        if (write_page != nullptr && !this->shared_pages.empty() && !this->page_dirty[this->page_index(write_page)]) {
+            write_page = nullptr;
+        }
+
+        this->read_pages[page] = read_page;
+        this->write_pages[page] = write_page;
+    }
+}
+
+void State::decode_tile(bool bank1, uint32_t tile)
+{
+    const uint8_t* src = (bank1 ? this->vram_banks : this->memory + 0x8000) + tile * 16;
+    uint8_t* dest = (bank1 ? this->tile_data2 : this->tile_data) + tile * 64;
+    decode_tile_rows(src, dest, 8);
+    this->tile_dirty[bank1][tile] = 0;
+}
+
+void State::mark_tiles_dirty(const uint8_t* vram, uint32_t len)
+{
+    bool bank1 = vram >= this->vram_banks && vram < this->vram_banks + 0x2000;
+    uint32_t offset = vram - (bank1 ? this->vram_banks : this->memory + 0x8000);
+    for (uint32_t tile = offset >> 4; len != 0 && tile < 0x180 && tile <= (offset + len - 1) >> 4; tile++) {
+        this->tile_dirty[bank1][tile] = 1;
     }
 }
 
@@ -1,20 +1,45 @@
 #pragma once
 
+#include "interrupts.h"
+#include "scheduler.h"
+
 #include <utility>
+#include <cstddef>
 #include <cstdint>
-#include <map>
+#include <memory>
 #include <string>
+#include <vector>
+
+class BlockCache;
+class Jit;
+class Mapper;
+class RomFile;
+class SnapshotReader;
+class SnapshotWriter;
+
+/* A machine state taken by State::fork(). Memory is kept as 4 KiB pages that
+ * are shared with other snapshots of the same machine when unchanged. */
+class StateSnapshot {
+friend class State;
+private:
+    std::vector<std::shared_ptr<const std::uint8_t[]>> pages;
+    std::vector<std::uint8_t> registers;
+};
 
 class State {
 public:
-    std::uint8_t a = 0, b = 0, c = 0, d = 0,
-            	 e = 0, h = 0, l = 0, f = 0;
-
+    /* Register file indexed by Register (B, C, D, E, H, L, A, F), followed by SP
+     * and PC so they all share a cache line. */
+    std::uint8_t registers[8]{0};
     std::uint16_t sp = 0xfffe, pc = 0x100;
+
+    /* Flags of the last ALU instruction are computed when F is read, see read_flags(). */
+    bool flags_pending = false;
+    std::uint16_t pending_flags_opcode = 0;
+    std::pair<std::uint16_t, std::uint16_t> pending_flags_operands = {0, 0};
+
     std::uint32_t instructions_executed = 0;
     std::uint32_t stack_depth = 0;
-    bool interrupts_enabled = false;
-    bool halt_mode = false;
     bool stop_mode = false;
     bool save_pending = false;
     bool cgb = false;
@@ -23,78 +48,168 @@ public:
 
     std::uint32_t prev_gdma_len = 0;
     std::uint32_t hdma_len = 0;
-    std::uint8_t* hdma_src = nullptr;
+    const std::uint8_t* hdma_src = nullptr;
     std::uint8_t* hdma_dest = nullptr;
 
+    Scheduler scheduler;
+    InterruptController interrupts;
+    /* DIV counts machine cycles from div_base. TIMA was tima_value at
+     * tima_base and has counted edges of the DIV bit selected by TAC since. */
+    std::uint64_t div_base = 0;
+    std::uint64_t tima_base = 0;
+    std::uint8_t tima_value = 0;
+    /* Line 0 of some frame started at lcd_base. While the LCD is on, LY and
+     * the STAT mode are read off the clock. */
+    std::uint64_t lcd_base = 0;
+    /* The host draws a line at each LCD_HBLANK. Without it, HBlank events
+     * only run while an HBlank DMA is going. */
+    bool draw_lines = true;
+
     std::uint8_t vram_bank = 0;
     std::uint8_t wram_bank = 1;
-    std::uint32_t ram_size = 0;
-    std::uint16_t rom_bank = 0;
-    std::uint16_t rom_banks = 0;
-    std::uint8_t ram_bank = 0;
-    std::uint8_t ram_banks = 0;
-    bool ram_enabled = false;
-    bool ram_bank_mode = false;
-
-    uint8_t rtc_seconds = 0;
-    uint8_t rtc_minutes = 0;
-    uint8_t rtc_hours = 0;
-    uint8_t rtc_days = 0;
-    uint8_t rtc_flags = 0;
-    uint8_t prev_rtc_latch = 0xff;
+    Mapper* mapper = nullptr;
 
+    /* Tiles decoded to one byte per pixel, 64 bytes per tile, for VRAM banks 0
+     * and 1. Use tile_row() to read them: tiles are only decoded again when
+     * VRAM writes or DMA have marked them in tile_dirty. */
     std::uint8_t* tile_data = nullptr;
     std::uint8_t* tile_data2 = nullptr;
+    std::uint8_t tile_dirty[2][0x180];
     std::uint8_t prev_oam_tile_ids[40]{0};
     std::uint8_t sorted_sprites[40]{0};
     std::uint8_t bg_palettes[0x40]{0};
     std::uint8_t obj_palettes[0x40]{0};
 
-    std::map<std::string, std::uint8_t*> registers {
-        {"A", &this->a},
-        {"B", &this->b},
-        {"C", &this->c},
-        {"D", &this->d},
-        {"E", &this->e},
-        {"H", &this->h},
-        {"L", &this->l},
-        {"F", &this->f}
-    };
-    std::map<std::string, std::pair<std::uint8_t*, std::uint8_t*>> register_pairs {
-        {"BC", {&this->b, &this->c}},
-        {"DE", {&this->d, &this->e}},
-        {"HL", {&this->h, &this->l}},
-        {"AF", {&this->a, &this->f}}
-    };
+    /* 64-byte lines of RAM holding cached blocks. Writing to such a line bumps
+     * its version, which tells the block cache to decode the code again. */
+    std::uint8_t code_lines[0x400]{0};
+    std::uint16_t code_line_versions[0x400]{0};
+    BlockCache* block_cache = nullptr;
+    Jit* jit = nullptr;
+
+    /* When set, write_memory records the address and previous value of every write. */
+    std::vector<std::pair<std::uint16_t, std::uint8_t>>* write_log = nullptr;
 
     State();
     ~State();
     State(const State& state) = delete;
     State& operator=(const State& state) = delete;
 
+    /* Pair n is registers 2n (high) and 2n + 1 (low), independent of host byte order. */
+    std::uint16_t read_pair(std::uint8_t pair) const
+    {
+        return this->registers[pair * 2] << 8 | this->registers[pair * 2 + 1];
+    }
+    void write_pair(std::uint8_t pair, std::uint16_t value)
+    {
+        this->registers[pair * 2] = value >> 8;
+        this->registers[pair * 2 + 1] = value & 0xff;
+    }
+
     void dump_memory_to_file(std::string filename,
 		             std::string memory);
     bool load_file_to_memory(std::string filename,
 		             std::string memory);
     bool load_file_to_rom(std::string filename);
+    /* Runs a PPU or timer event that was due at when */
+    void run_event(Event event, std::uint64_t when);
+    /* Toggles double speed mode, run by STOP after KEY1 prepared a switch.
+     * PPU and host events keep their real-time rate, so their distance in
+     * CPU cycles doubles or halves. */
+    void switch_speed();
+    /* Active low: right, left, up, down, then A, B, select, start from bit 0.
+     * Raises the joypad interrupt when a button in a selected group goes down. */
+    void set_buttons(std::uint8_t buttons);
+    /* The first cycle after since at which reading addr can return something
+     * else, without an event running or the CPU writing to it. */
+    std::uint64_t next_change(std::uint16_t addr, std::uint64_t since) const;
+    /* Backs cartridge RAM with the save file instead of loading a copy of it */
+    bool map_save_file(std::string filename);
+    /* Appends the CPU, memory, mapper, PPU and timer chunks. Loading refuses
+     * states of other ROMs, and leaves the machine as it was on failure. */
+    void save_state(SnapshotWriter& writer);
+    bool load_state(SnapshotReader& reader);
+    /* Branches the machine. Pages not written since the last fork() or
+     * restore() are shared with that snapshot instead of copied, so forking
+     * takes microseconds however large the cartridge RAM is. The first fork
+     * copies every page and turns on tracking of written pages. */
+    StateSnapshot fork();
+    /* Copies back only the pages that differ from the snapshot. Returns false
+     * for a snapshot of another cartridge. */
+    bool restore(const StateSnapshot& snapshot);
     std::uint8_t read_vram_bank(std::uint16_t addr);
-    std::uint8_t read_memory(std::uint16_t addr);
-    std::uint8_t read_mbc1(std::uint16_t addr);
-    std::uint8_t read_mbc2(std::uint16_t addr);
-    std::uint8_t read_mbc3(std::uint16_t addr);
-    std::uint8_t read_mbc5(std::uint16_t addr);
+    std::uint8_t read_memory(std::uint16_t addr)
+    {
+        const std::uint8_t* page = this->read_pages[addr >> 8];
+        return page != nullptr ? page[addr & 0xff] : this->read_special(addr);
+    }
+    std::uint8_t read_special(std::uint16_t addr);
     void run_hdma();
-    void write_memory(std::uint16_t addr, std::uint8_t value);
-    void write_mbc1(std::uint16_t addr, std::uint8_t value);
-    void write_mbc2(std::uint16_t addr, std::uint8_t value);
-    void write_mbc3(std::uint16_t addr, std::uint8_t value);
-    void write_mbc5(std::uint16_t addr, std::uint8_t value);
-    void update_tile_data();
+    void write_memory(std::uint16_t addr, std::uint8_t value)
+    {
+        std::uint8_t* page = this->write_pages[addr >> 8];
+        if (page != nullptr && this->write_log == nullptr && !this->code_lines[addr >> 6]) {
+            page[addr & 0xff] = value;
+        } else {
+            this->write_special(addr, value);
+        }
+    }
+    void write_special(std::uint16_t addr, std::uint8_t value);
+    const std::uint8_t* tile_row(bool bank1, std::uint32_t pixel_offset)
+    {
+        std::uint32_t tile = pixel_offset >> 6;
+        if (this->tile_dirty[bank1][tile]) {
+            this->decode_tile(bank1, tile);
+        }
+        return (bank1 ? this->tile_data2 : this->tile_data) + pixel_offset;
+    }
+    void decode_tile(bool bank1, std::uint32_t tile);
+    void mark_tiles_dirty(const std::uint8_t* vram, std::uint32_t len);
 private:
     std::uint8_t* memory = nullptr;
-    std::uint8_t* ram = nullptr;
-    std::uint8_t* rom = nullptr;
+    std::shared_ptr<const RomFile> rom_file;
+    const std::uint8_t* rom = nullptr;
     std::uint8_t* wram_banks = nullptr;
     std::uint8_t* vram_banks = nullptr;
+
+    /* Memory map in 256-byte pages. Pages backed by plain memory point into it,
+     * pages with side effects (MBC control, external RAM writes, RTC, I/O) are
+     * null and go through read_special() and write_special(). */
+    const std::uint8_t* read_pages[0x100]{nullptr};
+    std::uint8_t* write_pages[0x100]{nullptr};
+
+    /* Pages of memory, wram_banks, vram_banks and cartridge RAM as of the
+     * last fork() or restore(), empty until the first fork. Clean pages are
+     * left out of write_pages, so their first write marks them in page_dirty. */
+    std::vector<std::shared_ptr<const std::uint8_t[]>> shared_pages;
+    std::vector<std::uint8_t> page_dirty;
+
+    std::uint8_t buttons = 0xff;
+
+    void update_pages();
+    std::uint32_t lcd_position(std::uint64_t when) const;
+    std::uint8_t read_ly() const;
+    std::uint8_t read_stat() const;
+    /* Schedules the next LCD events after from */
+    void schedule_lcd(std::uint64_t from);
+    std::uint8_t read_tima() const;
+    void sync_timer();
+    void schedule_timer();
+    /* The low bits of P1: the buttons of the groups selected in 0xff00 */
+    std::uint8_t joypad_lines() const;
+    std::uint32_t page_count() const;
+    std::uint8_t* page_data(std::uint32_t page, std::uint32_t& size) const;
+    /* The page holding a byte of memory, or -1 */
+    std::int32_t page_index(const std::uint8_t* pointer) const;
+    void mark_pages_dirty(const std::uint8_t* pointer, std::uint32_t len);
+    void mark_address_dirty(std::uint16_t addr);
+    /* Drops blocks compiled from addr to addr + len */
+    void invalidate_code(std::uint32_t addr, std::uint32_t len);
+    void write_state(SnapshotWriter& writer, bool include_pages);
+    bool read_state(SnapshotReader& reader, bool include_pages);
+    /* Save states store pointers as an index into these and an offset */
+    std::vector<std::pair<const std::uint8_t*, std::size_t>> pointer_regions() const;
+    void save_pointer(SnapshotWriter& writer, const std::uint8_t* pointer) const;
+    bool load_pointer(SnapshotReader& reader, const std::uint8_t*& pointer) const;
 };
 
@@ -0,0 +1,102 @@
+#include "tile_decode.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define TILE_DECODE_X86
+#endif
+
+using std::memcpy;
+using std::size_t;
+using std::uint8_t;
+using std::uint32_t;
+using std::uint64_t;
+using std::vector;
+
+/* spread_bits[b] holds bit 7 - n of b in byte n of the word, in memory order. */
+static uint64_t spread_bits[256];
+
+static bool init_spread_bits()
+{
+    for (uint32_t b = 0; b < 256; b++) {
+        uint8_t bytes[8];
+	for (uint8_t n = 0; n < 8; n++) {
+            bytes[n] = (b >> (7 - n)) & 1;
+	}
+	memcpy(&spread_bits[b], bytes, 8);
+    }
+    return true;
+}
+
+static const bool spread_bits_ready = init_spread_bits();
+
+/* Bytes never exceed 3, so the two planes can be combined with plain
+ * arithmetic. This also beat an SSE2 unpack-based kernel, so there is no
+ * separate SSE2 path. */
+static void decode_tile_rows_scalar(const uint8_t* src, uint8_t* dest, size_t rows)
+{
+    for (size_t row = 0; row < rows; row++) {
+        uint64_t pixels = spread_bits[src[row * 2]] * 2 + spread_bits[src[row * 2 + 1]];
+	memcpy(dest + row * 8, &pixels, 8);
+    }
+}
+
+#ifdef TILE_DECODE_X86
+/* Eight rows per step. The rows are broadcast to both lanes, one in-lane
+ * shuffle per plane replicates the bytes of four rows to their pixels, and
+ * every pixel tests its own bit against a per-lane mask. */
+__attribute__((target("avx2")))
+static void decode_tile_rows_avx2(const uint8_t* src, uint8_t* dest, size_t rows)
+{
+    const __m256i bit_masks = _mm256_set1_epi64x(0x0102040810204080);
+    const __m256i twos = _mm256_set1_epi8(2);
+    const __m256i ones = _mm256_set1_epi8(1);
+    /* Row r of the step keeps its first byte at 2r and its second at 2r + 1 */
+    const __m256i spread1[2] = {
+        _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 2, 2, 2, 2,
+                         4, 4, 4, 4, 4, 4, 4, 4, 6, 6, 6, 6, 6, 6, 6, 6),
+        _mm256_setr_epi8(8, 8, 8, 8, 8, 8, 8, 8, 10, 10, 10, 10, 10, 10, 10, 10,
+                         12, 12, 12, 12, 12, 12, 12, 12, 14, 14, 14, 14, 14, 14, 14, 14)
+    };
+    const __m256i spread2[2] = {
+        _mm256_add_epi8(spread1[0], ones),
+        _mm256_add_epi8(spread1[1], ones)
+    };
+
+    size_t row = 0;
+    for (; row + 8 <= rows; row += 8) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + row * 2));
+	__m256i both_lanes = _mm256_broadcastsi128_si256(data);
+	for (size_t half = 0; half < 2; half++) {
+            __m256i bytes1 = _mm256_shuffle_epi8(both_lanes, spread1[half]);
+            __m256i bytes2 = _mm256_shuffle_epi8(both_lanes, spread2[half]);
+            __m256i set1 = _mm256_cmpeq_epi8(_mm256_and_si256(bytes1, bit_masks), bit_masks);
+            __m256i set2 = _mm256_cmpeq_epi8(_mm256_and_si256(bytes2, bit_masks), bit_masks);
+	    __m256i pixels = _mm256_or_si256(_mm256_and_si256(set1, twos), _mm256_and_si256(set2, ones));
+	    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + (row + half * 4) * 8), pixels);
+	}
+    }
+    decode_tile_rows_scalar(src + row * 2, dest + row * 8, rows - row);
+}
+#endif
+
+vector<TileDecoder> available_tile_decoders()
+{
+    vector<TileDecoder> decoders = {{"scalar", decode_tile_rows_scalar}};
+#ifdef TILE_DECODE_X86
+    if (__builtin_cpu_supports("avx2")) {
+        decoders.push_back({"avx2", decode_tile_rows_avx2});
+    }
+#endif
+    return decoders;
+}
+
+void decode_tile_rows(const uint8_t* src, uint8_t* dest, size_t rows)
+{
+    static const TileRowDecoder decoder = available_tile_decoders().back().decode;
+    decoder(src, dest, rows);
+}
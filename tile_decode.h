@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* Decodes rows of 2bpp tile data (two bytes per row of eight pixels) into one
+ * byte per pixel. Pixel n of a row is bit 7 - n of the first byte shifted left
+ * by one, or'ed with bit 7 - n of the second byte. */
+typedef void (*TileRowDecoder)(const std::uint8_t* src, std::uint8_t* dest, std::size_t rows);
+
+typedef struct TileDecoder {
+    const char* name;
+    TileRowDecoder decode;
+} TileDecoder;
+
+/* Uses the fastest kernel the CPU supports, picked on first use. */
+void decode_tile_rows(const std::uint8_t* src, std::uint8_t* dest, std::size_t rows);
+
+/* Every kernel the CPU can run, slowest first. */
+std::vector<TileDecoder> available_tile_decoders();
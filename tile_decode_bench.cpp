@@ -0,0 +1,71 @@
+#include "tile_decode.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+using std::cout;
+using std::memcmp;
+using std::mt19937;
+using std::size_t;
+using std::uint8_t;
+using std::uint32_t;
+using std::vector;
+
+/* The bit-at-a-time loop the emulator used before the kernels */
+static void decode_tile_rows_loop(const uint8_t* src, uint8_t* dest, size_t rows)
+{
+    for (size_t i = 0; i < rows; i++) {
+        uint8_t data1 = src[i * 2];
+        uint8_t data2 = src[i * 2 + 1];
+
+	for (int8_t n = 7; n >= 0; n--) {
+	    uint8_t pixel = 0;
+            pixel |= (data1 & (1 << n)) >> n << 1;
+            pixel |= (data2 & (1 << n)) >> n;
+	    dest[i * 8 + (7 - n)] = pixel;
+	}
+    }
+}
+
+/* Decodes both VRAM banks (0x1000 rows) repeatedly with every kernel, either
+ * in one call or one tile (8 rows) per call as the tile cache does. */
+int main()
+{
+    const size_t rows = 0x1000;
+    const uint32_t passes = 2000;
+    vector<uint8_t> vram(rows * 2);
+    mt19937 random(1);
+    for (uint8_t& byte : vram) {
+        byte = random();
+    }
+
+    vector<uint8_t> expected(rows * 8);
+    decode_tile_rows_loop(vram.data(), expected.data(), rows);
+
+    vector<TileDecoder> decoders = available_tile_decoders();
+    decoders.insert(decoders.begin(), {"loop", decode_tile_rows_loop});
+    for (const TileDecoder& decoder : decoders) {
+        vector<uint8_t> pixels(rows * 8);
+        for (size_t batch : {rows, size_t(8)}) {
+            auto start = steady_clock::now();
+	    for (uint32_t pass = 0; pass < passes; pass++) {
+                for (size_t row = 0; row < rows; row += batch) {
+                    decoder.decode(vram.data() + row * 2, pixels.data() + row * 8, batch);
+		}
+	    }
+	    duration<double> elapsed = steady_clock::now() - start;
+
+	    bool correct = memcmp(pixels.data(), expected.data(), pixels.size()) == 0;
+	    cout << decoder.name << (batch == 8 ? " (per tile)" : " (span)") << ": "
+	         << elapsed.count() * 1e9 / (passes * rows) << " ns/row"
+	         << (correct ? "" : " MISMATCH") << "\n";
+	}
+    }
+}